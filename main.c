@@ -30,8 +30,10 @@ void runAlgorithm(const TSPInstance* inst, const Settings* set){
 
 	if(error || (set->v && !checkSol(inst, &sol))){
 		printf("Error: invalid solution.\n\n");
-	}else if (set->v)
+	}else if (set->v){
+		printSol(inst, &sol);
         plotSolution(inst, &sol);
+	}/* if */
 		
     freeSol(&sol);
 
@@ -47,12 +49,16 @@ bool runConfig(CONF config, const Settings* set){
 	int error;
     TSPInstance inst;
 
+	rngSeed((*set).seed); /* the random choices of the algorithms are reproducible with a file input too */
+
     switch(config){
         case INPUT_FILE:
             error = readInstance(set, &inst);
             if(error){
                 if(error == -1)
                     printf("Error while opening the file \"%s\"\n\n", (*set).input_file_name);
+                else if(error == -3)
+                    printf("Only symmetric TSP instances (TYPE: TSP) with EDGE_WEIGHT_TYPE EUC_2D, CEIL_2D, ATT, GEO or EXPLICIT are supported.\n\n");
                 else
                     printf("The instance must contain at least three nodes and the number of nodes must have been specified into the input file.\n\n");
                 return 0;
@@ -154,7 +154,7 @@ void dummypatch(const Settings *set, const TSPInstance *inst, TSPSSolution *sol,
 void patch(const Settings *set, const TSPInstance *inst, TSPSSolution *sol, COMP *comp)
 {
 
-	int i, j, bi, bj, bdc;
+	int i, j, k, bi, bj, bdc;
 
 	/*if ((*set).v)
 		printf("\nStarting patching phase..\n");*/
@@ -162,9 +162,12 @@ void patch(const Settings *set, const TSPInstance *inst, TSPSSolution *sol, COMP
 	while ((*comp).nc > 1)
 	{
 		bdc = INT_MAX;
+
+		/* first the pairs of candidate neighbours, the best patch almost always joins close nodes */
 		for (i = 0; i < (*inst).dimension; i++)
-			for (j = i + 1; j < (*inst).dimension; j++)
-				/* I will not go twice on the same pair so i can check just for different components */
+			for (k = 0; k < (*inst).ncand; k++)
+			{
+				j = getCandidates(i, inst)[k];
 				if ((*comp).map[i] != (*comp).map[j])
 				{
 					int delta;
@@ -175,6 +178,26 @@ void patch(const Settings *set, const TSPInstance *inst, TSPSSolution *sol, COMP
 						bdc = delta;
 					}
 				} /* if */
+			} /* for */
+
+		/* no candidate pair joins two components, scan all of them */
+		if (bdc == INT_MAX)
+		{
+			for (i = 0; i < (*inst).dimension; i++)
+				for (j = i + 1; j < (*inst).dimension; j++)
+					/* I will not go twice on the same pair so i can check just for different components */
+					if ((*comp).map[i] != (*comp).map[j])
+					{
+						int delta;
+						if ((delta = delta_patch_cost(inst, sol, i, j)) < bdc)
+						{
+							bi = i;
+							bj = j;
+							bdc = delta;
+						}
+					} /* if */
+		} /* if */
+
 		patch_components(inst, bi, bj, sol, comp);
 	} /* while */
 
@@ -100,6 +100,7 @@ int hard_fixing(const Settings* set, const TSPInstance* inst, double fef, CPXENV
 	ArrayDinaInt fe;
 	Settings mipset;
 	TSPSolution temp;
+	SOL_CHECKER sc;
 	time_t start = time(0);
 
 	if(fef <= 0 || fef >= 1){
@@ -124,6 +125,7 @@ int hard_fixing(const Settings* set, const TSPInstance* inst, double fef, CPXENV
 
 	initArrayDinaInt((*inst).dimension, &fe);
 	allocSol((*inst).dimension, &temp);
+	allocSolChecker((*inst).dimension, &sc);
 	
 	initLB(inst, &lbc, lb);
 
@@ -146,7 +148,7 @@ int hard_fixing(const Settings* set, const TSPInstance* inst, double fef, CPXENV
 			break;
 		}/* if */
 
-		if(updateIncumbentSol(inst, &temp, sol))
+		if(updateIncumbentSol(inst, &temp, sol, &sc))
 			if((*set).v)
 				printf(" | Best solution cost found: %lf", sol->val);
 
@@ -164,6 +166,7 @@ int hard_fixing(const Settings* set, const TSPInstance* inst, double fef, CPXENV
 	free(lb[1]);
 	free(lb[0]);
 	free(lbc);
+	freeSolChecker(&sc);
 	freeSol(&temp);
 	freeArrayDinaInt(&fe);
 
@@ -93,6 +93,7 @@ int local_branching_k_start_step(const Settings* set, const TSPInstance* inst, i
 	double *vls, mipet, ls = -1;
 	Settings mipset;
 	TSPSolution temp;
+	SOL_CHECKER sc;
 	time_t start = time(0);
 
 	if((*set).v)
@@ -111,6 +112,7 @@ int local_branching_k_start_step(const Settings* set, const TSPInstance* inst, i
 	mipset.v = 0;
 
 	allocSol((*inst).dimension, &temp);
+	allocSolChecker((*inst).dimension, &sc);
 	
 	initIdxsVls(inst->dimension, &idxs, &vls);
 
@@ -136,7 +138,7 @@ int local_branching_k_start_step(const Settings* set, const TSPInstance* inst, i
 			break;
 		}/* if */
 
-		if((imp = updateIncumbentSol(inst, &temp, sol))){
+		if((imp = updateIncumbentSol(inst, &temp, sol, &sc))){
 			if((*set).v)
 				printf(" | Best solution cost found: %lf", sol->val);
 		}
@@ -152,6 +154,7 @@ int local_branching_k_start_step(const Settings* set, const TSPInstance* inst, i
 
 	free(vls);
 	free(idxs);
+	freeSolChecker(&sc);
 	freeSol(&temp);
 
 	*et = getSeconds(start);
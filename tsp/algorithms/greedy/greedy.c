@@ -0,0 +1,263 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : greedy.c
+*/
+
+#include <stdlib.h>
+#include <assert.h>
+#include <time.h>
+
+#include "greedy.h"
+#include "../../utility/utility.h"
+
+/*
+* IP i node index
+* IP j node index, different from $i
+* IP inst tsp instance
+* IOP edges array the edge is appended to
+* IOP m number of edges in $edges
+*/
+void addGreedyEdge(int i, int j, const TSPInstance* inst, GREEDY_EDGE* edges, size_t* m){
+
+	edges[*m].u = (i < j) ? i : j;
+	edges[*m].v = (i < j) ? j : i;
+	edges[*m].w = getDist(i, j, inst);
+
+	(*m)++;
+
+}/* addGreedyEdge */
+
+/*
+* IP inst tsp instance
+* OP edges candidate edges, allocated here, to free
+* OR number of candidate edges, an edge can appear twice
+* NB: the candidate lists of the instance if any, otherwise its Delaunay edges if computed, otherwise the edges to the
+*	GREEDY_NEIGHBOURS nearest nodes from $inst->kdtree, otherwise (metrics not ordered as the Euclidean one) every edge
+*/
+size_t collectGreedyEdges(const TSPInstance* inst, GREEDY_EDGE** edges){
+
+	int i, j, k, n = (*inst).dimension;
+	int nearest[GREEDY_NEIGHBOURS];
+	size_t m = 0, cap;
+	bool kd = isEuclideanNearest(inst) && (*inst).kdtree.nnodes > 0;
+
+	if((*inst).ncand > 0)
+		cap = (size_t)n * (*inst).ncand;
+	else if((*inst).delaunay.n > 0)
+		cap = (*inst).delaunay.first[n];
+	else if(kd)
+		cap = (size_t)n * GREEDY_NEIGHBOURS;
+	else
+		cap = (size_t)n * (n - 1) / 2;
+
+	*edges = malloc((cap > 0 ? cap : 1) * sizeof(GREEDY_EDGE));
+	assert(*edges != NULL);
+
+	for(i = 0; i < n; i++){
+
+		if((*inst).ncand > 0){
+
+			const int* cand = getCandidates(i, inst);
+
+			for(k = 0; k < (*inst).ncand; k++)
+				addGreedyEdge(i, cand[k], inst, *edges, &m);
+
+		}else if((*inst).delaunay.n > 0){
+
+			for(k = (*inst).delaunay.first[i]; k < (*inst).delaunay.first[i + 1]; k++)
+				addGreedyEdge(i, (*inst).delaunay.adj[k], inst, *edges, &m);
+
+		}else if(kd){
+
+			int found = kdKNearest(&((*inst).kdtree), NULL, (*inst).x[i], (*inst).y[i], i, GREEDY_NEIGHBOURS, nearest);
+
+			for(k = 0; k < found; k++)
+				addGreedyEdge(i, nearest[k], inst, *edges, &m);
+
+		}else
+			for(j = i + 1; j < n; j++)
+				addGreedyEdge(i, j, inst, *edges, &m);
+
+	}/* for */
+
+	return m;
+
+}/* collectGreedyEdges */
+
+/*
+* IP a pointer to the first edge
+* IP b pointer to the second edge
+* OR a negative number if the first edge comes first, a positive one if it comes after, 0 if they are the same edge
+* NB: the edges are ordered by cost, ties broken by the end nodes so that the tour does not depend on qsort
+*/
+int compareGreedyEdges(const void* a, const void* b){
+
+	const GREEDY_EDGE* ea = a;
+	const GREEDY_EDGE* eb = b;
+
+	if((*ea).w != (*eb).w)
+		return ((*ea).w < (*eb).w) ? -1 : 1;
+
+	if((*ea).u != (*eb).u)
+		return (*ea).u - (*eb).u;
+
+	return (*ea).v - (*eb).v;
+
+}/* compareGreedyEdges */
+
+/*
+* IP v node index
+* IOP parent union-find forest, the path from $v is halved
+* OR representative of the fragment of $v
+*/
+int findGreedyFragment(int v, int* parent){
+
+	while(parent[v] != v){
+		parent[v] = parent[parent[v]];
+		v = parent[v];
+	}/* while */
+
+	return v;
+
+}/* findGreedyFragment */
+
+/*
+* IP inst tsp instance
+* IP adj adj[2v], adj[2v + 1] neighbours of the node v in the fragments, -1 if missing
+* OP sol tour visiting the fragments one after the other
+* NB: from the last node of a fragment the walk goes on with the nearest end node of a fragment not visited yet, taken
+*	from $inst->kdtree (where the inner nodes of the fragments are deleted) when isEuclideanNearest, scanning the
+*	nodes otherwise
+*/
+void joinGreedyFragments(const TSPInstance* inst, const int* adj, TSPSolution* sol){
+
+	int v, a, prev, next, len = 0, n = (*inst).dimension;
+	bool kd = isEuclideanNearest(inst) && (*inst).kdtree.nnodes > 0;
+	bool* visited;
+	KDLive live;
+
+	visited = malloc(n * sizeof(bool));
+	assert(visited != NULL);
+
+	for(v = 0; v < n; v++)
+		visited[v] = false;
+
+	if(kd){
+
+		allocKDLive(&((*inst).kdtree), &live);
+
+		for(v = 0; v < n; v++)
+			if(adj[2 * v + 1] != -1)
+				kdDelete(&((*inst).kdtree), v, &live);
+
+	}/* if */
+
+	/* an end node of a fragment, there is one since the fragments have no cycles */
+	for(a = 0; a < n - 1 && adj[2 * a + 1] != -1; a++);
+
+	while(true){
+
+		for(prev = -1, v = a; v != -1; prev = v, v = next){
+
+			(*sol).path[len++] = v;
+			visited[v] = true;
+
+			if(kd)
+				kdDelete(&((*inst).kdtree), v, &live);
+
+			next = (adj[2 * v] != prev) ? adj[2 * v] : adj[2 * v + 1];
+
+		}/* for */
+
+		if(len == n)
+			break;
+
+		if(kd)
+			a = kdNearest(&((*inst).kdtree), &live, (*inst).x[prev], (*inst).y[prev], -1);
+		else
+			for(a = -1, v = 0; v < n; v++)
+				if(!visited[v] && adj[2 * v + 1] == -1 && (a == -1 || getDist(prev, v, inst) < getDist(prev, a, inst)))
+					a = v;
+
+	}/* while */
+
+	if(kd)
+		freeKDLive(&live);
+
+	free(visited);
+
+}/* joinGreedyFragments */
+
+/*
+* IP inst tsp instance to solve
+* OP sol greedy (multi-fragment) tour
+* OR int execution seconds
+* NB: the candidate edges (see collectGreedyEdges) are taken by increasing cost when both end nodes have less than two
+*	edges and are in different fragments, checked with a union-find forest, then the fragments are joined by
+*	joinGreedyFragments. O(n log n) with candidate lists, Delaunay edges or the k-d tree.
+*/
+int greedySol(const TSPInstance* inst, TSPSolution* sol){
+
+	time_t start = time(0);
+	int v, n = (*inst).dimension, added = 0;
+	int *adj, *parent, *size;
+	GREEDY_EDGE* edges;
+	size_t e, m;
+
+	adj = malloc(2 * n * sizeof(int));
+	assert(adj != NULL);
+
+	parent = malloc(n * sizeof(int));
+	assert(parent != NULL);
+
+	size = malloc(n * sizeof(int));
+	assert(size != NULL);
+
+	for(v = 0; v < n; v++){
+		adj[2 * v] = adj[2 * v + 1] = -1;
+		parent[v] = v;
+		size[v] = 1;
+	}/* for */
+
+	m = collectGreedyEdges(inst, &edges);
+
+	qsort(edges, m, sizeof(GREEDY_EDGE), compareGreedyEdges);
+
+	for(e = 0; e < m && added < n - 1; e++){
+
+		int u = edges[e].u, w = edges[e].v, ru, rw;
+
+		if((e > 0 && !compareGreedyEdges(&(edges[e - 1]), &(edges[e]))) || adj[2 * u + 1] != -1 || adj[2 * w + 1] != -1)
+			continue;
+
+		if((ru = findGreedyFragment(u, parent)) == (rw = findGreedyFragment(w, parent)))
+			continue;
+
+		/* union by size */
+		if(size[ru] < size[rw])
+			swapInt(&ru, &rw);
+
+		parent[rw] = ru;
+		size[ru] += size[rw];
+
+		adj[2 * u + (adj[2 * u] != -1)] = w;
+		adj[2 * w + (adj[2 * w] != -1)] = u;
+
+		added++;
+
+	}/* for */
+
+	joinGreedyFragments(inst, adj, sol);
+
+	(*sol).val = getSolCost(inst, sol);
+
+	free(edges);
+	free(size);
+	free(parent);
+	free(adj);
+
+	return getSeconds(start);
+
+}/* greedySol */
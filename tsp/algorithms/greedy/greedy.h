@@ -0,0 +1,19 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : greedy.h
+*/
+
+#pragma once
+
+#include "../../tsp.h"
+
+#define GREEDY_NEIGHBOURS 10 /* nearest nodes of each node whose edges are candidates, without candidate lists */
+
+typedef struct {
+	int u, v;	/* u, v := end nodes of the edge, u < v */
+	double w;	/* w    := cost of the edge */
+} GREEDY_EDGE;
+
+int greedySol(const TSPInstance*, TSPSolution*);
@@ -7,11 +7,14 @@
 
 #include <stdio.h> 
 #include <stdlib.h>
+#include <math.h>
 #include <time.h>
 #include <assert.h>
+#include <pthread.h>
 
 #include "nearestneighbor.h"
 #include "../../utility/utility.h"
+#include "../../point/hilbert/hilbert.h"
 #include "../refinement/2opt/2opt.h"
 
 #define TIMEOUT_WARNING_MESSAGE "Warning: The method exceeded the time limit! the solution that will be returned is the best founded so far\n\n"
@@ -50,6 +53,30 @@ void visitNext(int len, const TSPInstance* inst, TSPSolution* sol){
 
 }/* minDistNode */
 
+/*
+* As visitNext, the coordinates of the nodes of $sol->path[len..n) are packed in $xs[len..n), $ys[len..n) and moved
+* with them, so that the nearest one is found by nearestPoint on the squared distances.
+* IP len current index we have to update in $sol->path
+* IP inst tsp instance, isEuclideanNearest must hold
+* IOP xs x coordinates of the nodes of $sol->path
+* IOP ys y coordinates of the nodes of $sol->path
+* IOP sol solution we want to update
+* NB: on distinct distances the node chosen is the one of visitNext
+*/
+void visitNextPacked(int len, const TSPInstance* inst, double* xs, double* ys, TSPSolution* sol){
+
+	double d2;
+	int last = (*sol).path[len - 1];
+	int next = len + nearestPoint(xs[len - 1], ys[len - 1], xs + len, ys + len, (*inst).dimension - len, &d2);
+
+	swapInt(&((*sol).path[len]), &((*sol).path[next]));
+	swapDouble(&(xs[len]), &(xs[next]));
+	swapDouble(&(ys[len]), &(ys[next]));
+
+	(*sol).val += getDist(last, (*sol).path[len], inst);
+
+}/* visitNextPacked */
+
 /*
 * IP sp starting point index
 * IP inst tsp instance
@@ -65,23 +92,214 @@ void NN_initSol(int sp, const TSPInstance* inst, TSPSolution* sol){
 
 }/* initSol */
 
+/*
+* IP inst tsp instance
+* OR true if the nearest unvisited node is taken from the k-d tree of the instance
+* NB: the other metrics scan the unvisited nodes, see NN_solverScan
+*/
+bool isNNKDTree(const TSPInstance* inst){
+
+	if((*inst).dimension < NN_KDTREE_MIN_NODES || (*inst).kdtree.nnodes == 0)
+		return false;
+
+	return isEuclideanNearest(inst);
+
+}/* isNNKDTree */
+
+/*
+* IP inst tsp instance
+* OP near near[v] half the distance of the node v from its two nearest nodes, array of $inst->dimension elements
+*	assumed to be already allocated
+* OR sum of $near
+* NB: the two edges of a tour at v are at least as long as the two nearest ones, so the sum of $near over the nodes not
+*	visited yet bounds the cost to close a partial tour from below, with any metric
+*/
+double NN_closingBounds(const TSPInstance* inst, double* near){
+
+	int i, j, k, nearest[2];
+	double d, d1, d2, sum = 0;
+
+	for(i = 0; i < (*inst).dimension; i++){
+
+		d1 = d2 = INFINITY;
+
+		if(isNNKDTree(inst)){
+
+			k = kdKNearest(&((*inst).kdtree), NULL, (*inst).x[i], (*inst).y[i], i, 2, nearest);
+
+			if(k > 0)
+				d1 = getDist(i, nearest[0], inst);
+
+			if(k > 1)
+				d2 = getDist(i, nearest[1], inst);
+
+		}else
+			for(j = 0; j < (*inst).dimension; j++){
+
+				if(j == i)
+					continue;
+
+				d = getDist(i, j, inst);
+
+				if(d < d1){
+					d2 = d1;
+					d1 = d;
+				}else if(d < d2)
+					d2 = d;
+
+			}/* for */
+
+		near[i] = (d2 == INFINITY) ? 0 : (d1 + d2) / 2;
+		sum += near[i];
+
+	}/* for */
+
+	return sum;
+
+}/* NN_closingBounds */
+
+/*
+* IP val cost of the partial tour
+* IP rest lower bound on the cost to close the partial tour, see NN_closingBounds
+* IP bound cost of a complete tour
+* OR true if the partial tour cannot end up cheaper than $bound
+* NB: ties are kept so that the best start node does not depend on the bound, NN_PRUNE_TOLERANCE covers the rounding of
+*	the sums
+*/
+bool isNNHopeless(double val, double rest, double bound){
+
+	return val + rest > bound + NN_PRUNE_TOLERANCE * bound;
+
+}/* isNNHopeless */
+
+/*
+* IP sp starting point index
+* IP inst tsp instance to solve, isNNKDTree must hold
+* IOP live deletion state of $inst->kdtree, allocated, every node is restored before the search
+* IP near lower bounds on the cost of the nodes in a tour and their sum in $near[n], see NN_closingBounds, NULL if
+*	$bound is INFINITY
+* IP bound cost of the tour to beat, INFINITY to build the whole tour anyway
+* IOP sol tsp solution
+* OR false if the tour was abandoned because it cannot end up cheaper than $bound, see isNNHopeless
+* NB: O(n log n) expected on spread points, each visited node is deleted from the tree and the next one is the
+*	nearest not deleted. On distinct distances the tour is the one of the scan of visitNext.
+*/
+bool NN_solverKDTree(int sp, const TSPInstance* inst, KDLive* live, const double* near, double bound, TSPSolution* sol){
+
+	int curr, last = sp;
+	double rest = (near != NULL) ? near[(*inst).dimension] - near[sp] : 0;
+
+	resetKDLive(&((*inst).kdtree), live);
+
+	(*sol).path[0] = sp;
+	(*sol).val = 0;
+
+	kdDelete(&((*inst).kdtree), sp, live);
+
+	for(curr = 1; curr < (*inst).dimension; curr++){
+
+		int next = kdNearest(&((*inst).kdtree), live, (*inst).x[last], (*inst).y[last], -1);
+
+		kdDelete(&((*inst).kdtree), next, live);
+
+		(*sol).path[curr] = next;
+		(*sol).val += getDist(last, next, inst);
+
+		last = next;
+
+		if(near != NULL)
+			rest -= near[next];
+
+		if(isNNHopeless((*sol).val, rest, bound))
+			return false;
+
+	}/* for */
+
+	(*sol).val += getDist((*sol).path[0], last, inst); /* add cost of connection of last to first node */
+
+	return true;
+
+}/* NN_solverKDTree */
+
+/*
+* IP sp starting point index
+* IP inst tsp instance to solve
+* IP near lower bounds on the cost of the nodes in a tour and their sum in $near[n], see NN_closingBounds, NULL if
+*	$bound is INFINITY
+* IP bound cost of the tour to beat, INFINITY to build the whole tour anyway
+* IOP sol tsp solution
+* OR false if the tour was abandoned because it cannot end up cheaper than $bound, see isNNHopeless
+* NB: O(n^2), it scans the unvisited nodes at each step, with visitNextPacked if isEuclideanNearest and with visitNext otherwise
+*/
+bool NN_solverScan(int sp, const TSPInstance* inst, const double* near, double bound, TSPSolution* sol){
+
+	int curr, n = (*inst).dimension;
+	double rest = (near != NULL) ? near[n] - near[sp] : 0;
+	double *xs = NULL, *ys = NULL;
+	bool done = true;
+
+	NN_initSol(sp, inst, sol);
+
+	if(isEuclideanNearest(inst)){
+
+		xs = malloc(n * sizeof(double));
+		assert(xs != NULL);
+
+		ys = malloc(n * sizeof(double));
+		assert(ys != NULL);
+
+		for(curr = 0; curr < n; curr++){
+			xs[curr] = (*inst).x[(*sol).path[curr]];
+			ys[curr] = (*inst).y[(*sol).path[curr]];
+		}/* for */
+
+	}/* if */
+
+	for(curr = 1; curr < n && done; curr++){
+
+		if(xs != NULL)
+			visitNextPacked(curr, inst, xs, ys, sol);
+		else
+			visitNext(curr, inst, sol);
+
+		if(near != NULL)
+			rest -= near[(*sol).path[curr]];
+
+		done = !isNNHopeless((*sol).val, rest, bound);
+
+	}/* for */
+
+	free(ys);
+	free(xs);
+
+	if(done)
+		(*sol).val += getDist((*sol).path[0], (*sol).path[curr - 1], inst); /* add cost of connection of last to first node */
+
+	return done;
+
+}/* NN_solverScan */
+
 /*
 * IP sp starting point index
 * IP inst tsp instance to solve
 * IOP sol tsp solution
 * OR time at which solution was found
+* NB: see isNNKDTree for how the nearest unvisited node is found
 */
 int NN_solver(int sp, const TSPInstance* inst, TSPSolution* sol){
     
 	time_t start = time(0);
-	int curr;
 
-    NN_initSol(sp, inst, sol);
-    
-   for(curr=1; curr<inst->dimension; curr++)
-        visitNext(curr, inst, sol);
+	if(isNNKDTree(inst)){
+
+		KDLive live;
 
-    sol->val += getDist(sol->path[0], sol->path[curr-1], inst); /* add cost of connection of last to first node */
+		allocKDLive(&((*inst).kdtree), &live);
+		NN_solverKDTree(sp, inst, &live, NULL, INFINITY, sol);
+		freeKDLive(&live);
+
+	}else
+		NN_solverScan(sp, inst, NULL, INFINITY, sol);
 
     return getSeconds(start);
 
@@ -119,46 +337,197 @@ void NNBar(time_t start, int it, int n, int* ls){
 
 }/* NNBar */
 
+/*
+* IP inst tsp instance
+* OP order start nodes in the order best_start tries them, array of $inst->dimension elements assumed to be already allocated
+* NB: the nodes along the Hilbert curve taken in bit-reversed order, so that the first start nodes are spread over the
+*	whole instance and a good tour to prune the others with is likely found early
+*/
+void NN_startOrder(const TSPInstance* inst, int* order){
+
+	int* hilbert;
+	int k, r, b, m = 0, bits = 0, n = (*inst).dimension;
+
+	hilbert = malloc(n * sizeof(int));
+	assert(hilbert != NULL);
+
+	hilbertOrder(n, (*inst).x, (*inst).y, hilbert);
+
+	while((1 << bits) < n)
+		bits++;
+
+	for(k = 0; m < n; k++){
+
+		for(b = 0, r = 0; b < bits; b++)
+			r |= ((k >> b) & 1) << (bits - 1 - b);
+
+		if(r < n)
+			order[m++] = hilbert[r];
+
+	}/* for */
+
+	free(hilbert);
+
+}/* NN_startOrder */
+
+/*
+* IOP arg NN_CHUNK of the worker
+* OR NULL
+* NB: pthread entry point. The worker takes the next start node until there are none left or the time limit is
+*	reached (the first one is always tried), and keeps the best tour it finds, ties broken by the smallest start node.
+*	The tours that cannot beat the best one found by any worker are abandoned (the bound is read when a start node is
+*	taken), this never changes the best start node since the ties are not pruned.
+*/
+void* best_startChunk(void* arg){
+
+	NN_CHUNK* chunk = arg;
+	NN_SHARED* shared = (*chunk).shared;
+	const TSPInstance* inst = (*shared).inst;
+	bool kd = isNNKDTree(inst), done;
+	double bound;
+	int sp;
+
+	while(true){
+
+		pthread_mutex_lock(&((*shared).mutex));
+
+		if((*shared).next > 0 && (*shared).next < (*inst).dimension && isTimeOut((*shared).start, (*(*shared).set).tl))
+			(*shared).timeout = true;
+
+		if((*shared).timeout || (*shared).next >= (*inst).dimension){
+			pthread_mutex_unlock(&((*shared).mutex));
+			break;
+		}/* if */
+
+		sp = (*shared).order[(*shared).next++];
+		bound = (*shared).bound;
+
+		pthread_mutex_unlock(&((*shared).mutex));
+
+		if(kd)
+			done = NN_solverKDTree(sp, inst, &((*chunk).live), (*shared).near, bound, &((*chunk).temp));
+		else
+			done = NN_solverScan(sp, inst, (*shared).near, bound, &((*chunk).temp));
+
+		if(done && ((*chunk).sp < 0 || (*chunk).temp.val < (*chunk).best.val || ((*chunk).temp.val == (*chunk).best.val && sp < (*chunk).sp))){
+
+			cpSol(inst, &((*chunk).temp), &((*chunk).best));
+			(*chunk).sp = sp;
+
+			pthread_mutex_lock(&((*shared).mutex));
+			if((*chunk).best.val < (*shared).bound)
+				(*shared).bound = (*chunk).best.val;
+			pthread_mutex_unlock(&((*shared).mutex));
+
+		}/* if */
+
+		if((*chunk).bar){
+			pthread_mutex_lock(&((*shared).mutex));
+			NNBar((*shared).start, (*shared).next, (*inst).dimension, &((*shared).ls));
+			pthread_mutex_unlock(&((*shared).mutex));
+		}/* if */
+
+	}/* while */
+
+	return NULL;
+
+}/* best_startChunk */
+
 /*
 * IP set settings
 * IP inst tsp instance
+* IP nt number of threads
 * OP sol solution, the best founded within the time limit
 * OR int execution seconds
+* NB: each thread has its own scratch tours, the best tours of the threads are reduced at the end by cost and then by
+*	start node. The start nodes are tried in the order of NN_startOrder and the tours that cannot beat the best one so
+*	far are abandoned, see best_startChunk. Without a time limit stop the result does not depend on the number of
+*	threads. The chunks are run by runChunks, a chunk run late on the calling thread finds the start nodes already
+*	taken by the others.
 */
-double best_start(const Settings* set, const TSPInstance* inst, TSPSolution* sol){
-	
-	time_t start = time(0);
-	TSPSolution temp;
-	int i, ls = -1;
+double best_startThreads(const Settings* set, const TSPInstance* inst, int nt, TSPSolution* sol){
 
-	allocSol((*inst).dimension, &temp);
+	NN_SHARED shared;
+	NN_CHUNK* chunks;
+	int t, b = -1;
 
-	NN_solver(0, inst, sol);
+	shared.set = set;
+	shared.inst = inst;
+	shared.start = time(0);
+	shared.next = 0;
+	shared.bound = INFINITY;
+	shared.timeout = false;
+	shared.ls = -1;
+	pthread_mutex_init(&(shared.mutex), NULL);
 
-	if((*set).v)
-		NNBar(start, 1, (*inst).dimension, &ls);
+	shared.order = malloc((*inst).dimension * sizeof(int));
+	assert(shared.order != NULL);
 
-	for(i = 1; i < (*inst).dimension; i++){
+	NN_startOrder(inst, shared.order);
 
-		if(isTimeOutWarning(TIMEOUT_WARNING_MESSAGE, start, (*set).tl, (*set).v))
-			break;
+	/* $near[n] holds the sum */
+	shared.near = malloc(((*inst).dimension + 1) * sizeof(double));
+	assert(shared.near != NULL);
 
-		NN_solver(i, inst, &temp);
+	shared.near[(*inst).dimension] = NN_closingBounds(inst, shared.near);
 
-		if(temp.val < (*sol).val)
-			cpSol(inst, &temp, sol);
+	if(nt > (*inst).dimension)
+		nt = (*inst).dimension;
 
-		if((*set).v)
-			NNBar(start, i + 1, (*inst).dimension, &ls);
-			
+	if(nt < 1)
+		nt = 1;
+
+	chunks = malloc(nt * sizeof(NN_CHUNK));
+	assert(chunks != NULL);
+
+	for(t = 0; t < nt; t++){
+		chunks[t].shared = &shared;
+		chunks[t].sp = -1;
+		chunks[t].bar = (t == 0) && (*set).v;
+		allocSol((*inst).dimension, &(chunks[t].temp));
+		allocSol((*inst).dimension, &(chunks[t].best));
+		if(isNNKDTree(inst))
+			allocKDLive(&((*inst).kdtree), &(chunks[t].live));
 	}/* for */
 
-	if((*set).v)
+	runChunks(chunks, sizeof(NN_CHUNK), nt, best_startChunk);
+
+	for(t = 0; t < nt; t++)
+		if(chunks[t].sp >= 0 && (b < 0 || chunks[t].best.val < chunks[b].best.val || (chunks[t].best.val == chunks[b].best.val && chunks[t].sp < chunks[b].sp)))
+			b = t;
+
+	cpSol(inst, &(chunks[b].best), sol);
+
+	if(shared.timeout && (*set).v)
+		printf("\n\n" TIMEOUT_WARNING_MESSAGE);
+	else if((*set).v)
 		printf("\n\n");
 
-	freeSol(&temp);
-	
-	return getSeconds(start);
+	for(t = 0; t < nt; t++){
+		freeSol(&(chunks[t].best));
+		freeSol(&(chunks[t].temp));
+		if(isNNKDTree(inst))
+			freeKDLive(&(chunks[t].live));
+	}/* for */
+
+	free(chunks);
+	free(shared.near);
+	free(shared.order);
+	pthread_mutex_destroy(&(shared.mutex));
+
+	return getSeconds(shared.start);
+
+}/* best_startThreads */
+
+/*
+* IP set settings
+* IP inst tsp instance
+* OP sol solution, the best founded within the time limit, on all the available cores, see best_startThreads
+* OR int execution seconds
+*/
+double best_start(const Settings* set, const TSPInstance* inst, TSPSolution* sol){
+
+	return best_startThreads(set, inst, get_hardware_concurrency(), sol);
 
 }/* best_start */
 
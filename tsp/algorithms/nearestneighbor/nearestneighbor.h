@@ -5,8 +5,15 @@
 * File     : nearestneighbor.h
 */
 
+#include <pthread.h>
+#include <time.h>
+
 #include "../../tsp.h"
 #include "../../input/settings/settings.h"
+#include "../../point/kdtree/kdtree.h"
+
+#define NN_KDTREE_MIN_NODES 1000 /* smaller instances scan the unvisited nodes, see isNNKDTree */
+#define NN_PRUNE_TOLERANCE 1e-6 /* relative slack of the bound used to abandon the tours, see isNNHopeless */
 
 typedef enum{
     START_FIRST_NODE,
@@ -15,8 +22,48 @@ typedef enum{
     BEST_START
 } NN_CONFIG;
 
+/* state shared by the workers of best_startThreads */
+typedef struct {
+	const Settings* set;
+	const TSPInstance* inst;
+	time_t start;			/* start   := starting time of the search */
+	int* order;				/* order   := start nodes in the order they are tried, see NN_startOrder */
+	int next;				/* next    := index in $order of the next start node to try */
+	double* near;			/* near    := lower bounds on the cost of the nodes in a tour and their sum, see NN_closingBounds */
+	double bound;			/* bound   := cost of the best tour found so far by any worker, INFINITY if none */
+	bool timeout;			/* timeout := the time limit stopped the search before the last start node */
+	int ls;					/* ls      := last second the progress bar was printed */
+	pthread_mutex_t mutex;	/* mutex   := guards $next, $bound, $timeout and $ls */
+} NN_SHARED;
+
+/* scratch of a worker of best_startThreads */
+typedef struct {
+	NN_SHARED* shared;
+	TSPSolution temp;		/* temp := tour from the start node being tried */
+	TSPSolution best;		/* best := best tour found by the worker */
+	KDLive live;			/* live := unvisited nodes in the k-d tree of the instance (if isNNKDTree only) */
+	int sp;					/* sp   := start node of $best, -1 if the worker has not tried any */
+	bool bar;				/* bar  := the worker prints the progress bar */
+} NN_CHUNK;
+
+void visitNext(int, const TSPInstance*, TSPSolution*);
+
+void visitNextPacked(int, const TSPInstance*, double*, double*, TSPSolution*);
+
+void NN_initSol(int, const TSPInstance*, TSPSolution*);
+
+bool isNNKDTree(const TSPInstance*);
+
+bool NN_solverKDTree(int, const TSPInstance*, KDLive*, const double*, double, TSPSolution*);
+
+bool NN_solverScan(int, const TSPInstance*, const double*, double, TSPSolution*);
+
+int NN_solver(int, const TSPInstance*, TSPSolution*);
+
 int nearestNeighbor(const Settings*, const TSPInstance*, TSPSolution*);
 
+double best_startThreads(const Settings*, const TSPInstance*, int, TSPSolution*);
+
 double best_start(const Settings*, const TSPInstance*, TSPSolution*);
 
 int NNRunConfiguration(NN_CONFIG, const Settings*, const TSPInstance*, TSPSolution*);
@@ -6,6 +6,8 @@
 */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
 #include "2opt.h"
 #include "../../../utility/utility.h"
 #include "../tabu/tabu.h"
@@ -25,23 +27,258 @@ double delta2OptMoveCost(int i, int j, const TSPInstance* inst, const TSPSolutio
 
 }/* delta2OptMoveCost */
 
+/*
+* IP n number of nodes
+* IP i sol->path first index of the move
+* IP j sol->path second index of the move, i < j
+* OR true if path[i + 1..j] is not longer than the rest of the tour, the other side of the move
+*/
+bool isInner2OptSideShorter(int n, int i, int j){
+	return 2 * (j - i) <= n;
+}/* isInner2OptSideShorter */
+
 /*
 * IP i sol->path first index of the move
 * IP j sol->path second index of the move
 * IP inst tsp instance
 * IOP sol refined solution
-* NB: it assumes i < j
+* NB: it assumes i < j. Reversing path[i + 1..j] or the rest of the tour (path[j + 1..i] going through the end of the
+*	array) gives the same cycle, the shorter one is reversed.
 */
 void opt2move(int i, int j, const TSPInstance* inst, TSPSolution* sol){
 	
-	int s = i + 1, t = j;
+	int n = (*inst).dimension;
 
 	(*sol).val += delta2OptMoveCost(i, j, inst, sol);
 
-	invertArray(s, t, sol->path);
+	if(isInner2OptSideShorter(n, i, j))
+		invertArray(i + 1, j, sol->path);
+	else
+		invertArrayCyclic(n, (j + 1) % n, i, sol->path);
 	
 }/* opt2move */
 
+/*
+* IP n number of nodes
+* IP path sequence of the nodes
+* OP pos pos[path[i]] = i, array of $n elements assumed to be already allocated
+*/
+void initPathPos(int n, const int* path, int* pos){
+
+	for(int i = 0; i < n; i++)
+		pos[path[i]] = i;
+
+}/* initPathPos */
+
+/*
+* IP i sol->path first index of the move
+* IP j sol->path second index of the move
+* IP inst tsp instance
+* IOP sol refined solution
+* IOP pos positions of the nodes in sol->path, kept updated
+* NB: it assumes i < j, only the positions on the reversed side are updated
+*/
+void opt2movePos(int i, int j, const TSPInstance* inst, TSPSolution* sol, int* pos){
+
+	int n = (*inst).dimension, k;
+
+	opt2move(i, j, inst, sol);
+
+	if(isInner2OptSideShorter(n, i, j))
+		for(k = i + 1; k <= j; k++)
+			pos[(*sol).path[k]] = k;
+	else
+		for(k = (j + 1) % n; k != (i + 1) % n; k = (k + 1) % n)
+			pos[(*sol).path[k]] = k;
+
+}/* opt2movePos */
+
+/*
+* IP n number of nodes
+* IOP i sol->path first index of the move
+* IOP j sol->path second index of the move
+* OR true if (i, j) is a move that keeps a single cycle, in that case i < j on return
+*/
+bool normalize2OptMove(int n, int* i, int* j){
+
+	if(*i > *j)
+		swapInt(i, j);
+
+	return *j - *i >= 2 && (*i != 0 || *j != n - 1);
+
+}/* normalize2OptMove */
+
+/*
+* IP it current iteration, meaningful only with a tabu list
+* IP inst tsp instance, with candidate lists
+* IP sol solution
+* IP pos positions of the nodes in sol->path
+* IP tl tabu list, NULL to accept every move
+* OP opti sol->path first optimal index of the move, -1 if none
+* OP optj sol->path second optimal index of the move, -1 if none
+* OP optdelta the cost of the move
+* OR true if a (not tabu) move has been found
+* NB: only the moves adding the edge between a node and one of its candidate neighbours are evaluated, O(n k) instead of O(n^2):
+*	the ones where both are followed by the removed edges and the ones where both are preceded by them.
+*/
+bool getCand2OptMove(int it, const TSPInstance* inst, const TSPSolution* sol, const int* pos, const TABU_LIST* tl, int* opti, int* optj, double* optdelta){
+
+	int n = (*inst).dimension;
+	bool found = false;
+
+	*opti = *optj = -1;
+	*optdelta = 0;
+
+	for(int i = 0; i < n; i++){
+
+		const int* cand = getCandidates((*sol).path[i], inst);
+
+		for(int c = 0; c < (*inst).ncand; c++){
+
+			int moves[2][2] = {{i, pos[cand[c]]}, {(i + n - 1) % n, (pos[cand[c]] + n - 1) % n}};
+
+			for(int m = 0; m < 2; m++){
+
+				int a = moves[m][0], b = moves[m][1];
+
+				if(normalize2OptMove(n, &a, &b) && (tl == NULL || isNotTabuMove(it, inst, sol, tl, a, b))){
+
+					double temp = delta2OptMoveCost(a, b, inst, sol);
+
+					if(!found || temp < *optdelta){
+						found = true;
+						*opti = a;
+						*optj = b;
+						*optdelta = temp;
+					}/* if */
+
+				}/* if */
+
+			}/* for */
+
+		}/* for */
+
+	}/* for */
+
+	return found;
+
+}/* getCand2OptMove */
+
+/*
+* IP a node whose edges are examined
+* IP inst tsp instance, with candidate lists
+* IP tour tour
+* OP move nodes (a, b, c, d) of the best move, the path from $move[1] forward to $move[2] is reversed
+* OR the cost of the best move from $a, 0 if there is none
+* NB: as in getCand2OptMove, either both $a and its candidate neighbour are followed by the removed edges or both are
+*	preceded by them. Moves gaining less than OPT2_MIN_GAIN are ignored, a queue of nodes would cycle on rounding errors.
+*/
+double getTour2OptMove(int a, const TSPInstance* inst, const TSPTour* tour, int move[4]){
+
+	double optdelta = -OPT2_MIN_GAIN;
+	bool found = false;
+
+	for(int m = 0; m < 2; m++){
+
+		int b = (m == 0) ? tourNext(a, tour) : tourPrev(a, tour);
+		double ab = getDist(a, b, inst);
+		const int* cand = getCandidates(a, inst);
+
+		for(int k = 0; k < (*inst).ncand; k++){
+
+			int c = cand[k], d = (m == 0) ? tourNext(c, tour) : tourPrev(c, tour);
+			double delta;
+
+			if(c == b || d == a)
+				continue;
+
+			delta = getDist(a, c, inst) + getDist(b, d, inst) - ab - getDist(c, d, inst);
+
+			if(delta < optdelta){
+				found = true;
+				optdelta = delta;
+				/* a -> b ... c -> d reverses b..c, b -> a ... d -> c reverses a..d */
+				move[0] = a;
+				move[1] = (m == 0) ? b : a;
+				move[2] = (m == 0) ? c : d;
+				move[3] = d;
+			}/* if */
+
+		}/* for */
+
+	}/* for */
+
+	return found ? optdelta : 0;
+
+}/* getTour2OptMove */
+
+/*
+* IP set settings
+* IP inst tsp instance, with candidate lists
+* IOP tour refined tour
+* NB: the nodes to examine are kept in a FIFO queue, initially the whole tour; the best improving move from the head
+*	is performed and its four nodes are queued again, a node without improving moves leaves the queue. Each move is
+*	local, so with a TOUR_TWO_LEVEL tour the whole search costs O(sqrt(n)) per move instead of O(n).
+*	A move can also create one from a node out of the queue whose candidate is an end node of the move, so the whole
+*	tour is queued again until it has no improving move: the result is a local optimum of the candidate moves.
+*/
+void opt2Tour(const Settings* set, const TSPInstance* inst, TSPTour* tour){
+
+	time_t start = time(0);
+	double ls = -1, delta;
+	int n = (*tour).n, head = 0, size = 0, move[4], v;
+	int* queue = malloc(n * sizeof(int));
+	bool* queued = malloc(n * sizeof(bool));
+	bool moved = true, timeout = false;
+
+	assert(queue != NULL);
+	assert(queued != NULL);
+
+	while(moved && !timeout){
+
+		moved = false;
+		head = 0;
+		size = n;
+
+		v = 0;
+		for(int i = 0; i < n; i++, v = tourNext(v, tour)){
+			queue[i] = v;
+			queued[v] = true;
+		}/* for */
+
+		while(size > 0 && !timeout){
+
+			int a = queue[head];
+
+			if((delta = getTour2OptMove(a, inst, tour, move)) < 0){
+
+				reverseTourPath(move[1], move[2], tour);
+				(*tour).val += delta;
+				moved = true;
+
+				for(int m = 1; m < 4; m++)
+					if(!queued[move[m]]){
+						queued[move[m]] = true;
+						queue[(head + size++) % n] = move[m];
+					}/* if */
+
+				timeout = checkTimeLimit(set, start, &ls);
+
+			}else{
+				queued[a] = false;
+				head = (head + 1) % n;
+				size--;
+			}/* if */
+
+		}/* while */
+
+	}/* while */
+
+	free(queued);
+	free(queue);
+
+}/* opt2Tour */
+
 /*
 * IP inst tsp instance
 * IP sol solution
@@ -86,22 +323,36 @@ double getOpt2OptMove(const TSPInstance* inst, const TSPSolution* sol, int* opti
 * IP inst tsp instance
 * IOP sol refined solution
 * OR int execution seconds
-* NB: this method will perform the best move, not just the first one that improve the solution cost
+* NB: if the instance has candidate lists only the moves towards candidate neighbours are considered, looked for around
+*	the nodes in a queue (see opt2Tour) on the tour representation chosen by getTourKind. Otherwise this method will
+*	perform the best move of the whole tour, not just the first one that improve the solution cost.
 */
 double opt2(const Settings* set, const TSPInstance* inst, TSPSolution* sol){
 
 	time_t start = time(0);
 	double ls = -1;
-	int opti, optj; /* opti and optj are indexes in the sol->path array */
-	
-	while(getOpt2OptMove(inst, sol, &opti, &optj) < 0){
-		
-		opt2move(opti, optj, inst, sol);
+	int opti = -1, optj = -1; /* opti and optj are indexes in the sol->path array */
+	TSPTour tour;
 
-		if(checkTimeLimit(set, start, &ls))
-            return getSeconds(start);
+	if((*inst).ncand > 0){
 
-	}/* while */
+		allocTourKind((*inst).dimension, getTourKind((*inst).dimension), &tour);
+		convertSolTour(sol, &tour);
+
+		opt2Tour(set, inst, &tour);
+
+		convertTourSol(&tour, sol);
+		freeTour(&tour);
+
+	}else
+		while(getOpt2OptMove(inst, sol, &opti, &optj) < 0){
+			
+			opt2move(opti, optj, inst, sol);
+
+			if(checkTimeLimit(set, start, &ls))
+				return getSeconds(start);
+
+		}/* while */
 
 	if((*set).v)
 		processBar(1, 1);
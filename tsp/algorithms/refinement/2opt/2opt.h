@@ -5,10 +5,27 @@
 * File     : 2opt.h
 */
 
+#pragma once
+
 #include "../../../tsp.h"
+#include "../tabu/tabu.h"
+
+#define OPT2_MIN_GAIN 1e-9 /* smaller gains are rounding errors of the distances */
 
 double opt2(const Settings*, const TSPInstance*, TSPSolution*);
 
+bool isInner2OptSideShorter(int, int, int);
+
 void opt2move(int, int, const TSPInstance*, TSPSolution*);
 
 double delta2OptMoveCost(int, int, const TSPInstance*, const TSPSolution*);
+
+void initPathPos(int, const int*, int*);
+
+void opt2movePos(int, int, const TSPInstance*, TSPSolution*, int*);
+
+double getTour2OptMove(int, const TSPInstance*, const TSPTour*, int[4]);
+
+void opt2Tour(const Settings*, const TSPInstance*, TSPTour*);
+
+bool getCand2OptMove(int, const TSPInstance*, const TSPSolution*, const int*, const TABU_LIST*, int*, int*, double*);
@@ -135,6 +135,7 @@ bool isNotTabuMove(int it, const TSPInstance* inst, const TSPSolution* sol, cons
 * IP it current iteration
 * IP inst tsp instance
 * IP sol solution
+* IP pos positions of the nodes in sol->path, used only if the instance has candidate lists
 * OP i sol->path first optimal index of the move
 * OP j sol->path second optimal index of the move
 * OR bool true if a not tabu move is founded, false otherwise
@@ -142,11 +143,14 @@ bool isNotTabuMove(int it, const TSPInstance* inst, const TSPSolution* sol, cons
 * 		break the cycle we are no longer able to reconstruct it.
 	Note also that the optimal move can increase the solution cost.
 */
-bool getOptNotTabu2OptMove(int it, const TSPInstance* inst, const TSPSolution* sol, const TABU_LIST* tl, int* opti, int* optj){
+bool getOptNotTabu2OptMove(int it, const TSPInstance* inst, const TSPSolution* sol, const int* pos, const TABU_LIST* tl, int* opti, int* optj){
 
 	double optdelta;
 	bool notTabu = false;
 
+	if((*inst).ncand > 0)
+		return getCand2OptMove(it, inst, sol, pos, tl, opti, optj, &optdelta);
+
 	for(int i = 0; i < (*inst).dimension - 2; i++)	/* Note that j = i + 2 avoids to take b = a1 */
 												    /* Note that j < (*inst).dimension => i < (*inst).dimension - 2 */
 		for(int j = i + 2; j < (*inst).dimension; j++){
@@ -197,12 +201,13 @@ void updateTabuList(int it, const TSPInstance* inst, const TSPSolution* sol, int
 * OP j sol->path second index of the move
 * OP tl tabu list to be updated
 * IOP sol refined solution
+* IOP pos positions of the nodes in sol->path, kept updated
 */
-void tabuMove(const TSPInstance* inst, int it, int i, int j, TABU_LIST* tl, TSPSolution* sol){
+void tabuMove(const TSPInstance* inst, int it, int i, int j, TABU_LIST* tl, TSPSolution* sol, int* pos){
 
-	opt2move(i, j, inst, sol);
+	updateTabuList(it, inst, sol, i, j, tl); /* before the move, that can reverse the side holding path[i] */
 
-	updateTabuList(it, inst, sol, i, j, tl);
+	opt2movePos(i, j, inst, sol, pos);
 
 }/* tabuMove */
 
@@ -216,27 +221,35 @@ void tabu(const Settings* set, const TSPInstance* inst, TSPSolution* sol, tenure
 
 	time_t start = time(0);
 	TSPSolution temp;
+	SOL_CHECKER sc;
 	TABU_LIST tl; /* TABU list */
 	FILE* cost_pipe;
 	int it = 0;
 	int opti, optj; /* opti and optj are indexes in the sol->path array */
+	int* pos; /* pos := positions of the nodes in temp.path */
 	double ls = -1, lp = -1; /* ls := last stamp, seconds from the start to the last stamp */
 
 	if((*set).v)
 		initCostPlotPipe("TABU - Solutions Costs", &cost_pipe);
 
 	allocSol((*inst).dimension, &temp);
+	allocSolChecker((*inst).dimension, &sc);
 	initTabuList(inst, &tl, tf);
 
 	cpSol(inst, sol, &temp);
 
+	pos = malloc((*inst).dimension * sizeof(int));
+	assert(pos != NULL);
+
+	initPathPos((*inst).dimension, temp.path, pos);
+
 	while(true){
 
-		if(getOptNotTabu2OptMove(it, inst, &temp, &tl, &opti, &optj)){
+		if(getOptNotTabu2OptMove(it, inst, &temp, pos, &tl, &opti, &optj)){
 			
-			tabuMove(inst, it, opti, optj, &tl, &temp);
+			tabuMove(inst, it, opti, optj, &tl, &temp, pos);
 
-			updateIncumbentSol(inst, &temp, sol);
+			updateIncumbentSol(inst, &temp, sol, &sc);
             
 		}/* if */
 		
@@ -250,7 +263,9 @@ void tabu(const Settings* set, const TSPInstance* inst, TSPSolution* sol, tenure
 
 	}/* while */
 
+	free(pos);
 	freeTabuList(&tl);
+	freeSolChecker(&sc);
 	freeSol(&temp);
 	
 	if((*set).v)
@@ -5,6 +5,8 @@
 * File     : tabu.h
 */
 
+#pragma once
+
 #include "../../../tsp.h"
 #include "../../../array/array.h"
 
@@ -24,6 +26,8 @@ typedef struct{
 
 void tabu(const Settings*, const TSPInstance*, TSPSolution*, tenurefunc);
 
+bool isNotTabuMove(int, const TSPInstance*, const TSPSolution*, const TABU_LIST*, int, int);
+
 int defaulttenure(int, int);
 
 int triangulartenure(int, int);
@@ -79,18 +79,28 @@ void selectRandomIndexes_v2(int n, int* i, int* j, int* k){
 /*
 * IP inst tsp instance
 * IOP sol solution to be modified
+* NB: the edges (path[i], path[i+1]), (path[j], path[j+1]) and (path[k], path[k+1]) are replaced by (path[i], path[j]),
+*	(path[i+1], path[k]) and (path[j+1], path[k+1]), the cost is updated with their difference
 */
 void randomized3Kick(const TSPInstance* inst, TSPSolution* sol){
     
-    int i, j, k;
+    int i, j, k, n = inst->dimension;
+    int a, a1, b, b1, c, c1;
 
-    selectRandomIndexes_v2(inst->dimension, &i, &j, &k);
+    selectRandomIndexes_v2(n, &i, &j, &k);
+
+    a = sol->path[i];
+    a1 = sol->path[i+1];
+    b = sol->path[j];
+    b1 = sol->path[j+1];
+    c = sol->path[k];
+    c1 = sol->path[(k+1) % n];
 
     invertArray(i+1, j, sol->path);
 
     invertArray(j+1, k, sol->path);
 
-    sol->val = getSolCost(inst, sol);
+    sol->val += getDist(a, b, inst) + getDist(a1, c, inst) + getDist(b1, c1, inst) - (getDist(a, a1, inst) + getDist(b, b1, inst) + getDist(c, c1, inst));
 
 }/* randomized3Opt */
 
@@ -116,6 +126,7 @@ void vns(const Settings* set, const TSPInstance* inst, TSPSolution* sol){
 
     time_t start = time(0);
     TSPSolution temp;
+    SOL_CHECKER sc;
     FILE* pipe;
     Settings vns_set;
 	double ls = -1;
@@ -129,6 +140,7 @@ void vns(const Settings* set, const TSPInstance* inst, TSPSolution* sol){
     	initCostPlotPipe("VNS - Solutions Costs", &pipe);
 
     allocSol(inst->dimension, &temp);
+    allocSolChecker(inst->dimension, &sc);
 
     cpSol(inst, sol, &temp);
 
@@ -136,7 +148,7 @@ void vns(const Settings* set, const TSPInstance* inst, TSPSolution* sol){
 
         vns_set.tl -= opt2(set, inst, &temp);
 
-        updateIncumbentSol(inst, &temp, sol);
+        updateIncumbentSol(inst, &temp, sol, &sc);
 
 		iter++;
 		
@@ -151,6 +163,7 @@ void vns(const Settings* set, const TSPInstance* inst, TSPSolution* sol){
 
     }
 
+    freeSolChecker(&sc);
     freeSol(&temp);
 	
 	if((*set).v)
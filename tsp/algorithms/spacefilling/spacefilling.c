@@ -0,0 +1,31 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : spacefilling.c
+*/
+
+#include <time.h>
+
+#include "spacefilling.h"
+#include "../../point/hilbert/hilbert.h"
+#include "../../utility/utility.h"
+
+/*
+* IP inst tsp instance to solve
+* OP sol tour visiting the nodes in the order of the Hilbert curve over their coordinates
+* OR int execution seconds
+* NB: O(n log n) on all the available cores (see hilbertOrderThreads) plus the n distances of the cost, no distance
+*	matrix is needed. Without coordinates (explicit instances) the tour is the ascending one.
+*/
+int hilbertSol(const TSPInstance* inst, TSPSolution* sol){
+
+	time_t start = time(0);
+
+	hilbertOrder((*inst).dimension, (*inst).x, (*inst).y, (*sol).path);
+
+	(*sol).val = getSolCost(inst, sol);
+
+	return getSeconds(start);
+
+}/* hilbertSol */
@@ -0,0 +1,12 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : spacefilling.h
+*/
+
+#pragma once
+
+#include "../../tsp.h"
+
+int hilbertSol(const TSPInstance*, TSPSolution*);
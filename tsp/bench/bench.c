@@ -0,0 +1,478 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : bench.c
+*/
+
+#define _POSIX_C_SOURCE 199309L /* clock_gettime */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <assert.h>
+
+#include "bench.h"
+#include "../utility/utility.h"
+#include "../input/generator/generator.h"
+#include "../input/reader/reader.h"
+#include "../algorithms/refinement/2opt/2opt.h"
+#include "../algorithms/nearestneighbor/nearestneighbor.h"
+#include "../elite/elite.h"
+
+/*
+* OR wall clock time in seconds from an arbitrary origin
+* NB: time(0) has a resolution of one second, too coarse for the kernels measured here
+*/
+double wallSeconds(void){
+
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+
+}/* wallSeconds */
+
+/*
+* IOP inst instance whose matrix is rebuilt
+* IP rowf kernel used to build the rows
+* IP nt number of threads
+* OR best time in seconds out of BENCH_REPETITIONS builds of the matrix
+*/
+double timeDistances(TSPInstance* inst, distrowfunc rowf, int nt){
+
+	int r;
+	double best = 0;
+
+	for(r = 0; r < BENCH_REPETITIONS; r++){
+
+		double et = wallSeconds();
+
+		computeDistancesThreads(inst, rowf, nt);
+
+		et = wallSeconds() - et;
+
+		if(r == 0 || et < best)
+			best = et;
+
+	}/* for */
+
+	return best;
+
+}/* timeDistances */
+
+/*
+* IP set settings, $set->n nodes generated with $set->seed
+* OV time to build the distance matrix with the scalar and the vectorised kernels, on one and on all the cores
+*/
+void benchDistances(const Settings* set){
+
+	TSPInstance scalar, simd;
+	int nt = get_hardware_concurrency();
+	double ts, tv, tp;
+	size_t bytes = triangularIndex((*set).n, 0) * sizeof(double);
+
+	allocInstBackend((*set).n, DIST_MATRIX, DIST_TRIANGULAR, DIST_DOUBLE, &scalar);
+	allocInstBackend((*set).n, DIST_MATRIX, DIST_TRIANGULAR, DIST_DOUBLE, &simd);
+
+	generateInstanceName(set, true, "BENCH", &scalar);
+	generateInstanceName(set, true, "BENCH", &simd);
+
+	printf("Distance matrix, %d nodes, %.1lf MB:\n", (*set).n, bytes / 1e6);
+
+	ts = timeDistances(&scalar, (distrowfunc)distanceRowScalar, 1);
+	tv = timeDistances(&simd, (distrowfunc)distanceRow, 1);
+
+	printf("\tscalar kernel:     %10.4lf s\n", ts);
+	printf("\tvectorised kernel: %10.4lf s (speedup %.2lfx)\n", tv, ts / tv);
+	printBool("\tbit-identical: ", !memcmp(scalar.dist, simd.dist, bytes));
+
+	tp = timeDistances(&scalar, (distrowfunc)distanceRow, nt);
+
+	printf("\tvectorised kernel on %d threads: %10.4lf s (speedup %.2lfx)\n", nt, tp, ts / tp);
+	printBool("\tbit-identical: ", !memcmp(scalar.dist, simd.dist, bytes));
+	printf("\n");
+
+	freeInst(&simd);
+	freeInst(&scalar);
+
+}/* benchDistances */
+
+/*
+* IP set settings, $set->input_file_name is the TSPLIB file parsed
+* OV time to parse the file compared with the time to just read it, as MB/s and nodes/s
+* NB: the file is read once before timing, so both measures run on the page cache and not on the disk
+*/
+void benchParse(const Settings* set){
+
+	TSPInstance inst;
+	FILE* fp;
+	char* buffer;
+	long bytes;
+	int r, n = 0;
+	double tr = 0, tp = 0;
+
+	if((fp = fopen((*set).input_file_name, "rb")) == NULL){
+		printf("Cannot open the file %s\n\n", (*set).input_file_name);
+		return;
+	}/* if */
+
+	fseek(fp, 0, SEEK_END);
+	bytes = ftell(fp);
+
+	buffer = malloc(bytes + 1);
+	assert(buffer != NULL);
+
+	for(r = 0; r <= BENCH_REPETITIONS; r++){
+
+		double et = wallSeconds();
+
+		rewind(fp);
+		if(fread(buffer, 1, bytes, fp) != (size_t)bytes)
+			printf("Short read of %s\n", (*set).input_file_name);
+
+		et = wallSeconds() - et;
+
+		if(r == 1 || (r > 1 && et < tr))
+			tr = et;
+
+	}/* for */
+
+	free(buffer);
+	fclose(fp);
+
+	for(r = 0; r < BENCH_REPETITIONS; r++){
+
+		double et = wallSeconds();
+
+		if(parseInstance(set, &inst, NULL)){
+			printf("Cannot parse the file %s\n\n", (*set).input_file_name);
+			return;
+		}/* if */
+
+		et = wallSeconds() - et;
+
+		n = inst.dimension;
+		freeInst(&inst);
+
+		if(r == 0 || et < tp)
+			tp = et;
+
+	}/* for */
+
+	printf("TSPLIB parsing, %s, %d nodes, %.1lf MB:\n", (*set).input_file_name, n, bytes / 1e6);
+	printf("\tread only: %10.4lf s (%.0lf MB/s)\n", tr, bytes / 1e6 / tr);
+	printf("\tparse:     %10.4lf s (%.0lf MB/s, %.2lf Mnodes/s, %.2lfx the read time)\n", tp, bytes / 1e6 / tp, n / 1e6 / tp, tp / tr);
+	printf("\n");
+
+}/* benchParse */
+
+/*
+* IP set settings, $set->n nodes, the moves are drawn from $set->seed
+* OV elements moved and time per 2-opt move, reversing path[i + 1..j] one swap at a time as opt2move did, with the
+*	vectorised kernel, and reversing the shorter side of the move with the vectorised kernel as opt2move does
+* NB: the same BENCH_REVERSAL_MOVES uniformly random moves are applied by each strategy to the same path
+*/
+void benchReversal(const Settings* set){
+
+	const char* names[3] = {"path[i + 1..j], scalar:    ", "path[i + 1..j], vectorised:", "shorter side, vectorised:  "};
+	int n = (*set).n, m, v, k, i, j;
+	int* moves = malloc(2 * BENCH_REVERSAL_MOVES * sizeof(int));
+	int* path = malloc(n * sizeof(int));
+	int* scalar = malloc(n * sizeof(int));
+	RNG rng;
+
+	assert(moves != NULL);
+	assert(path != NULL);
+	assert(scalar != NULL);
+
+	rngInit((*set).seed, RNG_MAIN_STREAM, &rng);
+
+	for(m = 0; m < BENCH_REVERSAL_MOVES; m++){
+
+		do{
+			i = rngBelow(&rng, n);
+			j = rngBelow(&rng, n);
+			if(i > j)
+				swapInt(&i, &j);
+		}while(j - i < 2 || (i == 0 && j == n - 1));
+
+		moves[2 * m] = i;
+		moves[2 * m + 1] = j;
+
+	}/* for */
+
+	printf("2-opt reversals, %d nodes, %d random moves:\n", n, BENCH_REVERSAL_MOVES);
+
+	for(v = 0; v < 3; v++){
+
+		double et, elements = 0;
+
+		for(k = 0; k < n; k++)
+			path[k] = k;
+
+		et = wallSeconds();
+
+		for(m = 0; m < BENCH_REVERSAL_MOVES; m++){
+
+			i = moves[2 * m];
+			j = moves[2 * m + 1];
+
+			if(v == 0)
+				invertArrayScalar(i + 1, j, path);
+			else if(v == 1 || isInner2OptSideShorter(n, i, j))
+				invertArray(i + 1, j, path);
+			else
+				invertArrayCyclic(n, (j + 1) % n, i, path);
+
+			elements += (v < 2 || isInner2OptSideShorter(n, i, j)) ? j - i : n - (j - i);
+
+		}/* for */
+
+		et = wallSeconds() - et;
+
+		if(v == 0)
+			memcpy(scalar, path, n * sizeof(int));
+
+		printf("\t%s %10.1lf elements per move, %10.1lf ns per move\n", names[v], elements / BENCH_REVERSAL_MOVES, et * 1e9 / BENCH_REVERSAL_MOVES);
+
+		if(v == 1)
+			printBool("\tsame path with both kernels: ", !memcmp(scalar, path, n * sizeof(int)));
+
+	}/* for */
+
+	printf("\n");
+
+	free(scalar);
+	free(path);
+	free(moves);
+
+}/* benchReversal */
+
+/*
+* IP set settings, $set->n nodes generated with $set->seed
+* OV time to build the nearest neighbor tour from the node 0 by scanning the unvisited nodes with getDist, by scanning
+*	their packed coordinates with the vectorised kernel and by querying the k-d tree
+* NB: the tours match only if the instance has no ties among the distances, each time is the one of a single tour
+*/
+void benchNearestNeighbor(const Settings* set){
+
+	const char* names[3] = {"scan with getDist:        ", "scan of packed coordinates:", "k-d tree:                  "};
+	TSPInstance inst;
+	TSPSolution sol, scan;
+	KDLive live;
+	double *xs, *ys;
+	int v, k;
+
+	generateInstance(set, &inst);
+
+	if(!isEuclideanNearest(&inst)){
+		freeInst(&inst);
+		return;
+	}/* if */
+
+	allocSol(inst.dimension, &sol);
+	allocSol(inst.dimension, &scan);
+	allocKDLive(&(inst.kdtree), &live);
+
+	xs = malloc(inst.dimension * sizeof(double));
+	assert(xs != NULL);
+
+	ys = malloc(inst.dimension * sizeof(double));
+	assert(ys != NULL);
+
+	printf("Nearest neighbor tour, %d nodes:\n", inst.dimension);
+
+	for(v = 0; v < 3; v++){
+
+		double et = wallSeconds();
+
+		if(v == 2)
+			NN_solverKDTree(0, &inst, &live, NULL, INFINITY, &sol);
+		else{
+
+			NN_initSol(0, &inst, &sol);
+
+			for(k = 0; k < inst.dimension; k++){
+				xs[k] = inst.x[sol.path[k]];
+				ys[k] = inst.y[sol.path[k]];
+			}/* for */
+
+			for(k = 1; k < inst.dimension; k++)
+				if(v == 0)
+					visitNext(k, &inst, &sol);
+				else
+					visitNextPacked(k, &inst, xs, ys, &sol);
+
+			sol.val += getDist(sol.path[0], sol.path[inst.dimension - 1], &inst);
+
+		}/* if */
+
+		et = wallSeconds() - et;
+
+		if(v == 0)
+			cpSol(&inst, &sol, &scan);
+
+		printf("\t%s %10.4lf s, cost %.2lf\n", names[v], et, sol.val);
+
+		if(v > 0)
+			printBool("\tsame tour as the scan with getDist: ", !memcmp(scan.path, sol.path, inst.dimension * sizeof(int)));
+
+	}/* for */
+
+	printf("\n");
+
+	free(ys);
+	free(xs);
+	freeKDLive(&live);
+	freeSol(&scan);
+	freeSol(&sol);
+	freeInst(&inst);
+
+}/* benchNearestNeighbor */
+
+/*
+* IP set settings, $set->n nodes generated with $set->seed
+* OV time per tour offered to an elite pool of BENCH_ELITE_CAPACITY tours with mindist BENCH_ELITE_MOVES, and how many
+*	of them are kept
+* NB: the tours are the identity tour after 1 to BENCH_ELITE_MOVES random 2-opt moves, so a part of them is too similar
+*	to be kept. It asserts that the pool never exceeds its capacity while tours are replaced, and that a rotated and
+*	a reversed copy of a tour in the pool are rejected as duplicates.
+*/
+void benchElitePool(const Settings* set){
+
+	TSPInstance inst;
+	TSPSolution first, sol, copy;
+	ELITE_POOL pool;
+	RNG rng;
+	int t, m, k, i, j, n, size, added = 0, replaced = 0;
+	bool found, rotated, reversed;
+	double et = 0;
+
+	generateInstance(set, &inst);
+	n = inst.dimension;
+
+	allocSol(n, &first);
+	allocSol(n, &sol);
+	allocSol(n, &copy);
+
+	for(k = 0; k < n; k++)
+		first.path[k] = k;
+	first.val = getSolCost(&inst, &first);
+
+	rngInit((*set).seed, RNG_MAIN_STREAM, &rng);
+
+	initElitePool(BENCH_ELITE_CAPACITY, n, BENCH_ELITE_MOVES, &pool);
+
+	for(t = 0; t < BENCH_ELITE_TOURS; t++){
+
+		double start;
+
+		cpSol(&inst, &first, &sol);
+
+		for(m = rngBelow(&rng, BENCH_ELITE_MOVES) + 1; m > 0; m--){
+
+			do{
+				i = rngBelow(&rng, n);
+				j = rngBelow(&rng, n);
+				if(i > j)
+					swapInt(&i, &j);
+			}while(j - i < 2 || (i == 0 && j == n - 1));
+
+			opt2move(i, j, &inst, &sol);
+
+		}/* for */
+
+		size = sizeElitePool(&pool);
+
+		start = wallSeconds();
+
+		if(addElitePool(&sol, &pool)){
+			added++;
+			replaced += (size == BENCH_ELITE_CAPACITY);
+		}/* if */
+
+		et += wallSeconds() - start;
+
+		assert(sizeElitePool(&pool) <= BENCH_ELITE_CAPACITY);
+
+	}/* for */
+
+	/* a copy of the best tour starting from another node, then the same tour walked backwards */
+	size = sizeElitePool(&pool);
+	found = getElitePool(0, &sol, &pool);
+	assert(found);
+
+	for(k = 0; k < n; k++)
+		copy.path[k] = sol.path[(k + n / 2) % n];
+	copy.val = sol.val;
+
+	rotated = addElitePool(&copy, &pool);
+
+	for(k = 0; k < n; k++)
+		copy.path[k] = sol.path[n - 1 - k];
+
+	reversed = addElitePool(&copy, &pool);
+
+	assert(!rotated && !reversed && sizeElitePool(&pool) == size);
+
+	printf("Elite pool, %d nodes, %d tours offered:\n", n, BENCH_ELITE_TOURS);
+	printf("\t%10.1lf us per tour, %d kept (%d replacing another one), %d in the pool\n", et * 1e6 / BENCH_ELITE_TOURS, added, replaced, size);
+	printBool("\trotated and reversed copies rejected: ", !rotated && !reversed);
+	printf("\n");
+
+	freeElitePool(&pool);
+	freeSol(&copy);
+	freeSol(&sol);
+	freeSol(&first);
+	freeInst(&inst);
+
+}/* benchElitePool */
+
+/*
+* OV help section
+*/
+void bench_help(void){
+
+	printf("Benchmark options:\n");
+	printf("\t-f, --file  <file_name>\t\tTSPLIB file whose parsing is measured\n");
+	printf("\t-n, --nodes <number_of_nodes>\tnumber of nodes of the random instance to build\n");
+	printf("\t-s, --seed  <seed_value>\tseed used for random generation (integer value)\n");
+	printf("\n");
+
+}/* bench_help */
+
+/*
+* IP argc number of elements contained in $argv
+* IP argv command line arguments
+* OR 0 if no error, 1 otherwise
+*/
+int main(int argc, char* const* argv){
+
+	Settings set;
+	CONF conf = parseCMDLine(argc, argv, &set);
+
+	if(conf == INPUT_FILE){
+		benchParse(&set);
+		return 0;
+	}/* if */
+
+	if(conf != RANDOM_GENERATION){
+		bench_help();
+		return 1;
+	}/* if */
+
+	benchDistances(&set);
+
+	benchReversal(&set);
+
+	benchNearestNeighbor(&set);
+
+	benchElitePool(&set);
+
+	return 0;
+
+}/* main */
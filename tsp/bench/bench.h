@@ -0,0 +1,26 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : bench.h
+*/
+
+#include "../tsp.h"
+
+#define BENCH_REPETITIONS 5 /* each measure is the best out of BENCH_REPETITIONS runs */
+#define BENCH_REVERSAL_MOVES 10000 /* random 2-opt moves applied by each reversal strategy */
+#define BENCH_ELITE_TOURS 1000 /* tours offered to the elite pool */
+#define BENCH_ELITE_CAPACITY 10 /* tours kept by the elite pool */
+#define BENCH_ELITE_MOVES 20 /* each tour offered to the elite pool is the first one after 1 to BENCH_ELITE_MOVES random 2-opt moves */
+
+double wallSeconds(void);
+
+void benchDistances(const Settings*);
+
+void benchParse(const Settings*);
+
+void benchReversal(const Settings*);
+
+void benchNearestNeighbor(const Settings*);
+
+void benchElitePool(const Settings*);
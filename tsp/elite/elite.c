@@ -0,0 +1,269 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : elite.c
+*/
+
+#include <stdlib.h>
+#include <assert.h>
+
+#include "elite.h"
+#include "../utility/utility.h"
+
+/*
+* IP u first end of the edge
+* IP v second end of the edge
+* OR pseudo-random 64-bit key of the undirected edge {u, v}, edgeKey(u, v) = edgeKey(v, u)
+*/
+uint64_t edgeKey(int u, int v){
+
+	uint64_t x;
+
+	if(u > v)
+		swapInt(&u, &v);
+
+	x = ELITE_HASH_SEED ^ (((uint64_t)u << 32) | (uint32_t)v);
+
+	return splitmix64(&x);
+
+}/* edgeKey */
+
+/*
+* IP n number of nodes
+* IP path nodes in the order they are visited
+* OR xor of the keys of the edges of the tour, the same for every first node and direction of the tour
+*/
+uint64_t tourHash(int n, const int* path){
+
+	int i;
+	uint64_t h = 0;
+
+	for(i = 0; i < n; i++)
+		h ^= edgeKey(path[i], path[(i + 1 < n) ? i + 1 : 0]);
+
+	return h;
+
+}/* tourHash */
+
+/*
+* IP capacity maximum number of tours
+* IP n number of nodes of the tours
+* IP mindist minimum number of different edges from each tour in the pool, see ELITE_POOL
+* OP pool empty pool
+*/
+void initElitePool(int capacity, int n, int mindist, ELITE_POOL* pool){
+
+	int i;
+
+	(*pool).size = 0;
+	(*pool).capacity = capacity;
+	(*pool).n = n;
+	(*pool).mindist = mindist;
+
+	(*pool).sols = malloc(capacity * sizeof(TSPSolution));
+	assert((*pool).sols != NULL);
+
+	for(i = 0; i < capacity; i++)
+		allocSol(n, &((*pool).sols[i]));
+
+	(*pool).hash = malloc(capacity * sizeof(uint64_t));
+	assert((*pool).hash != NULL);
+
+	(*pool).adj = malloc(2 * n * sizeof(int));
+	assert((*pool).adj != NULL);
+
+	pthread_mutex_init(&((*pool).mutex), NULL);
+
+}/* initElitePool */
+
+/*
+* IOP pool pool to free memory
+*/
+void freeElitePool(ELITE_POOL* pool){
+
+	int i;
+
+	pthread_mutex_destroy(&((*pool).mutex));
+
+	free((*pool).adj);
+	free((*pool).hash);
+
+	for(i = 0; i < (*pool).capacity; i++)
+		freeSol(&((*pool).sols[i]));
+
+	free((*pool).sols);
+
+}/* freeElitePool */
+
+/*
+* IP sol tour
+* IOP pool pool whose $adj is filled with the neighbours of each node in $sol
+*/
+void fillAdjacency(const TSPSolution* sol, ELITE_POOL* pool){
+
+	int i, n = (*pool).n;
+
+	for(i = 0; i < n; i++){
+		(*pool).adj[2 * (*sol).path[i]] = (*sol).path[(i + 1 < n) ? i + 1 : 0];
+		(*pool).adj[2 * (*sol).path[i] + 1] = (*sol).path[(i > 0) ? i - 1 : n - 1];
+	}/* for */
+
+}/* fillAdjacency */
+
+/*
+* IP sol tour
+* IP pool pool whose $adj holds the neighbours of the nodes in the other tour, see fillAdjacency
+* OR number of edges of $sol that the other tour does not have, 0 if they are the same tour
+*/
+int edgeDistance(const TSPSolution* sol, const ELITE_POOL* pool){
+
+	int i, u, v, n = (*pool).n, dist = 0;
+
+	for(i = 0; i < n; i++){
+
+		u = (*sol).path[i];
+		v = (*sol).path[(i + 1 < n) ? i + 1 : 0];
+
+		if((*pool).adj[2 * u] != v && (*pool).adj[2 * u + 1] != v)
+			dist++;
+
+	}/* for */
+
+	return dist;
+
+}/* edgeDistance */
+
+/*
+* IP sol tour to add, its $val is its cost
+* IOP pool pool
+* OR true if $sol has been added
+* NB: a tour already in the pool is never added again. While the pool is not full every other tour is added, then:
+*	- a tour not better than the worst one is discarded;
+*	- a tour not better than the best one is discarded if it has fewer than $mindist edges that some tour in the pool
+*		does not have (too similar);
+*	- otherwise it replaces, among the tours that are worse than it, the one with the fewest different edges (ties
+*		broken by the worst cost), so the pool stays spread out.
+*	The hash is computed before locking the pool, the comparisons take O(n) each.
+*/
+bool addElitePool(const TSPSolution* sol, ELITE_POOL* pool){
+
+	int i, dist, victim = -1, victimdist = 0, mindist = (*pool).n, best = 0, worst = 0;
+	uint64_t h = tourHash((*pool).n, (*sol).path);
+	bool filled = false;
+
+	pthread_mutex_lock(&((*pool).mutex));
+
+	for(i = 0; i < (*pool).size; i++){
+
+		if((*pool).sols[i].val < (*pool).sols[best].val)
+			best = i;
+
+		if((*pool).sols[i].val > (*pool).sols[worst].val)
+			worst = i;
+
+		if((*pool).hash[i] != h)
+			continue;
+
+		if(!filled){
+			fillAdjacency(sol, pool);
+			filled = true;
+		}/* if */
+
+		if(edgeDistance(&((*pool).sols[i]), pool) == 0){ /* duplicate */
+			pthread_mutex_unlock(&((*pool).mutex));
+			return false;
+		}/* if */
+
+	}/* for */
+
+	if((*pool).size < (*pool).capacity)
+		victim = (*pool).size++;
+	else if((*sol).val < (*pool).sols[worst].val){
+
+		if(!filled)
+			fillAdjacency(sol, pool);
+
+		for(i = 0; i < (*pool).size; i++){
+
+			dist = edgeDistance(&((*pool).sols[i]), pool);
+
+			if(dist < mindist)
+				mindist = dist;
+
+			if((*pool).sols[i].val > (*sol).val && (victim < 0 || dist < victimdist || (dist == victimdist && (*pool).sols[i].val > (*pool).sols[victim].val))){
+				victim = i;
+				victimdist = dist;
+			}/* if */
+
+		}/* for */
+
+		if((*sol).val >= (*pool).sols[best].val && mindist < (*pool).mindist)
+			victim = -1;
+
+	}/* if */
+
+	if(victim >= 0){
+		for(i = 0; i < (*pool).n; i++)
+			(*pool).sols[victim].path[i] = (*sol).path[i];
+		(*pool).sols[victim].val = (*sol).val;
+		(*pool).hash[victim] = h;
+	}/* if */
+
+	pthread_mutex_unlock(&((*pool).mutex));
+
+	return victim >= 0;
+
+}/* addElitePool */
+
+/*
+* IOP pool pool
+* OR number of tours in the pool
+*/
+int sizeElitePool(ELITE_POOL* pool){
+
+	int size;
+
+	pthread_mutex_lock(&((*pool).mutex));
+	size = (*pool).size;
+	pthread_mutex_unlock(&((*pool).mutex));
+
+	return size;
+
+}/* sizeElitePool */
+
+/*
+* IP i rank of the tour, 0 is the best one
+* OP sol copy of the i-th best tour in the pool, assumed to be already allocated
+* IOP pool pool
+* OR false if the pool has fewer than $i + 1 tours
+* NB: O(capacity^2 + n), the pool is small
+*/
+bool getElitePool(int i, TSPSolution* sol, ELITE_POOL* pool){
+
+	int j, k, rank;
+	bool found = false;
+
+	pthread_mutex_lock(&((*pool).mutex));
+
+	for(j = 0; j < (*pool).size && !found; j++){
+
+		/* rank := number of tours before the j-th one, ties broken by position */
+		for(rank = 0, k = 0; k < (*pool).size; k++)
+			if((*pool).sols[k].val < (*pool).sols[j].val || ((*pool).sols[k].val == (*pool).sols[j].val && k < j))
+				rank++;
+
+		if(rank == i){
+			for(k = 0; k < (*pool).n; k++)
+				(*sol).path[k] = (*pool).sols[j].path[k];
+			(*sol).val = (*pool).sols[j].val;
+			found = true;
+		}/* if */
+
+	}/* for */
+
+	pthread_mutex_unlock(&((*pool).mutex));
+
+	return found;
+
+}/* getElitePool */
@@ -0,0 +1,47 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : elite.h
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include "../tsp.h"
+
+#define ELITE_HASH_SEED 0x5eed7a11e11e5eedULL /* mixed into the keys of the edges */
+
+/*
+* Bounded pool of good and different tours. Each tour is hashed as the xor of the keys of its undirected edges
+* (Zobrist hashing, the key of an edge is computed from its ends instead of looked up in an n x n table), so the
+* hash does not depend on the first node or on the direction of the tour. Equal hashes are confirmed by comparing
+* the edges. The pool can be shared by several threads, every access holds its mutex.
+*/
+typedef struct {
+	TSPSolution* sols;		/* sols     := tours in the pool, the first $size are used */
+	uint64_t* hash;			/* hash     := hash[i] hash of the edges of sols[i] */
+	int* adj;				/* adj      := adj[2v], adj[2v + 1] neighbours of v in the tour being added */
+	int size;				/* size     := number of tours in the pool */
+	int capacity;			/* capacity := maximum number of tours in the pool */
+	int n;					/* n        := number of nodes of the tours */
+	int mindist;			/* mindist  := a tour not better than the best one is added only if it has at least $mindist
+											edges that each tour in the pool does not have */
+	pthread_mutex_t mutex;
+} ELITE_POOL;
+
+uint64_t edgeKey(int, int);
+
+uint64_t tourHash(int, const int*);
+
+void initElitePool(int, int, int, ELITE_POOL*);
+
+void freeElitePool(ELITE_POOL*);
+
+bool addElitePool(const TSPSolution*, ELITE_POOL*);
+
+int sizeElitePool(ELITE_POOL*);
+
+bool getElitePool(int, TSPSolution*, ELITE_POOL*);
@@ -0,0 +1,357 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : cache.c
+*/
+
+#define _POSIX_C_SOURCE 200112L /* open, fstat, mmap */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include "cache.h"
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+/*
+* IP data bytes to hash
+* IP bytes number of bytes
+* IP h hash of the bytes before
+* OR FNV-1a hash of the bytes, continuing from $h
+*/
+uint64_t fnv1a(const void* data, size_t bytes, uint64_t h){
+
+	const unsigned char* p = data;
+
+	for(size_t i = 0; i < bytes; i++){
+		h ^= p[i];
+		h *= FNV_PRIME;
+	}/* for */
+
+	return h;
+
+}/* fnv1a */
+
+/*
+* IP text content of a TSPLIB file
+* IP bytes size of $text
+* OR hash of the content, what ties a cache file to the TSPLIB file it was written from
+* NB: FNV-1a taken a word at a time, each step is a bijection of the hash so any single changed word changes it. The
+*	words are read in the byte order of the machine, as the rest of the cache file.
+*/
+uint64_t sourceHash(const void* text, size_t bytes){
+
+	const unsigned char* p = text;
+	uint64_t h = FNV_OFFSET, w;
+	size_t i;
+
+	for(i = 0; i + sizeof(w) <= bytes; i += sizeof(w)){
+		memcpy(&w, p + i, sizeof(w));
+		h = (h ^ w) * FNV_PRIME;
+	}/* for */
+
+	return fnv1a(p + i, bytes - i, h);
+
+}/* sourceHash */
+
+/*
+* IP name name of the file
+* OP hash sourceHash of the content of the file
+* OR Result code (
+   0: success;
+   -1: the file cannot be read;
+)
+*/
+int fileHash(const char name[], uint64_t* hash){
+
+	struct stat st;
+	void* text;
+	int fd;
+
+	if((fd = open(name, O_RDONLY)) == -1)
+		return -1;
+
+	if(fstat(fd, &st) || st.st_size == 0){
+		close(fd);
+		return -1;
+	}/* if */
+
+	text = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if(text == MAP_FAILED)
+		return -1;
+
+	*hash = sourceHash(text, st.st_size);
+
+	munmap(text, st.st_size);
+
+	return 0;
+
+}/* fileHash */
+
+/*
+* IP inst tsp instance
+* OR hash of the name, the dimension, the coordinates and the original ids of the nodes of $inst
+* NB: it is computed from the cache file itself, so it detects a damaged cache file, not a changed TSPLIB file (see
+*	sourceHash). The distances are not hashed, they would take most of the loading time.
+*/
+uint64_t instanceHash(const TSPInstance* inst){
+
+	uint64_t h = FNV_OFFSET;
+	int32_t n = (*inst).dimension;
+
+	h = fnv1a((*inst).name, strlen((*inst).name), h);
+	h = fnv1a(&n, sizeof(n), h);
+
+	for(int i = 0; i < n; i++){
+		h = fnv1a(&((*inst).points[i].x), sizeof(double), h);
+		h = fnv1a(&((*inst).points[i].y), sizeof(double), h);
+	}/* for */
+
+	if((*inst).orig != NULL)
+		h = fnv1a((*inst).orig, n * sizeof(int), h);
+
+	return h;
+
+}/* instanceHash */
+
+/*
+* IP input name of the TSPLIB file
+* OP cache name of its cache file, array of MAX_CACHE_NAME_SIZE elements
+*/
+void cacheFileName(const char input[], char cache[]){
+	sprintf(cache, "%s%s", input, TSPBIN_EXTENSION);
+}/* cacheFileName */
+
+/*
+* IP h header of the cache file
+* IP bytes size of the cache file
+* IP src status of the TSPLIB file
+* IP set settings
+* OR true if the cache file is consistent, was written with the same settings and from a TSPLIB file of the same size
+* NB: only the cheap checks, the content of the TSPLIB file is compared by mapInstanceCache
+*/
+bool isValidCache(const TSPBinHeader* h, size_t bytes, const struct stat* src, const Settings* set){
+
+	size_t n = (*h).dimension;
+
+	if(memcmp((*h).magic, TSPBIN_MAGIC, sizeof(TSPBIN_MAGIC)) || (*h).version != TSPBIN_VERSION || (*h).byte_order != TSPBIN_BYTE_ORDER)
+		return false;
+
+	if((*h).source_size != (uint64_t)(*src).st_size)
+		return false;
+
+	if((*h).metric < METRIC_EUC_2D || (*h).metric > METRIC_EXPLICIT || ((*h).metric == METRIC_EXPLICIT && !(*h).has_dist))
+		return false;
+
+	/* an explicit instance is never renumbered (see renumberHilbert) */
+	if((*h).dimension <= 2 || (*h).renumbered != ((*set).hr && (*h).metric != METRIC_EXPLICIT) || (*h).precision != (*set).dp)
+		return false;
+
+	if((*h).coords_offset + 2 * n * sizeof(double) > bytes || ((*h).renumbered && (*h).orig_offset + n * sizeof(int) > bytes))
+		return false;
+
+	if((*h).has_dist && ((*h).dist_offset % TSPBIN_PAGE || (*h).dist_offset + (*h).dist_bytes > bytes ||
+			(*h).dist_bytes != distEntries((*h).dimension, (*h).layout) * distEntrySize((*h).precision)))
+		return false;
+
+	return (*h).name[MAX_NAME_LENGTH - 1] == '\0';
+
+}/* isValidCache */
+
+/*
+* IP set settings
+* OP inst tsp instance loaded from the cache file of $set->input_file_name, with the matrix (if stored) used in place
+*	from a read-only mapping of the file
+* OR Result code (
+   0: success;
+   -1: no valid cache file;
+)
+* NB: the cache is valid if it was written from a TSPLIB file with the same content (size and sourceHash) with the
+*	same renumbering and precision and it is not damaged (see instanceHash). The TSPLIB file is read once to be
+*	hashed, still much cheaper than parsing it. computeDistances is still needed to build what depends on the
+*	coordinates, it does not touch the mapped matrix.
+*/
+int mapInstanceCache(const Settings* set, TSPInstance* inst){
+
+	char name[MAX_CACHE_NAME_SIZE];
+	struct stat src, st;
+	const TSPBinHeader* h;
+	const double *x, *y;
+	void* map;
+	int i, fd;
+	uint64_t source;
+
+	cacheFileName((*set).input_file_name, name);
+
+	if(stat((*set).input_file_name, &src) || (fd = open(name, O_RDONLY)) == -1)
+		return -1;
+
+	if(fstat(fd, &st) || (size_t)st.st_size < sizeof(TSPBinHeader)){
+		close(fd);
+		return -1;
+	}/* if */
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); /* the mapping outlives the descriptor */
+
+	if(map == MAP_FAILED)
+		return -1;
+
+	h = map;
+
+	if(!isValidCache(h, st.st_size, &src, set) || fileHash((*set).input_file_name, &source) || source != (*h).source_hash){
+		munmap(map, st.st_size);
+		return -1;
+	}/* if */
+
+	/* no block is allocated for the matrix, it is the mapped one */
+	allocInstBackend((*h).dimension, DIST_ON_THE_FLY, (*h).layout, (*h).precision, inst);
+
+	strcpy((*inst).name, (*h).name);
+	(*inst).metric = (*h).metric;
+
+	x = (const double*)((const char*)map + (*h).coords_offset);
+	y = x + (*h).dimension;
+
+	for(i = 0; i < (*h).dimension; i++){
+		(*inst).points[i].x = x[i];
+		(*inst).points[i].y = y[i];
+	}/* for */
+
+	if((*h).renumbered){
+
+		(*inst).orig = malloc((*h).dimension * sizeof(int));
+		assert((*inst).orig != NULL);
+
+		memcpy((*inst).orig, (const char*)map + (*h).orig_offset, (*h).dimension * sizeof(int));
+
+	}/* if */
+
+	(*inst).map = map;
+	(*inst).map_bytes = st.st_size;
+
+	if(instanceHash(inst) != (*h).hash){
+		freeInst(inst);
+		return -1;
+	}/* if */
+
+	if((*h).has_dist){
+
+		void* block = (char*)map + (*h).dist_offset;
+
+		(*inst).backend = DIST_MATRIX;
+
+		if((*inst).precision == DIST_NINT)
+			(*inst).idist = block;
+		else if((*inst).precision == DIST_FLOAT)
+			(*inst).fdist = block;
+		else
+			(*inst).dist = block;
+
+	}else{
+
+		munmap(map, st.st_size);
+		(*inst).map = NULL;
+		(*inst).map_bytes = 0;
+
+	}/* if */
+
+	return 0;
+
+}/* mapInstanceCache */
+
+/*
+* IP set settings
+* IP inst tsp instance read from $set->input_file_name, with the distances already computed
+* IP source sourceHash of the content of $set->input_file_name $inst was parsed from
+* OF cache file of $set->input_file_name
+* OR Result code (
+   0: success;
+   -1: the cache file cannot be written;
+)
+* NB: the file is written under a temporary name and then renamed, so that a run never maps a partial file
+*/
+int writeInstanceCache(const Settings* set, const TSPInstance* inst, uint64_t source){
+
+	char name[MAX_CACHE_NAME_SIZE], temp[MAX_CACHE_NAME_SIZE];
+	struct stat src;
+	TSPBinHeader h;
+	FILE* file;
+	const void* block;
+	size_t n = (*inst).dimension, pos;
+	bool ok;
+
+	if(stat((*set).input_file_name, &src))
+		return -1;
+
+	memset(&h, 0, sizeof(h));
+
+	memcpy(h.magic, TSPBIN_MAGIC, sizeof(TSPBIN_MAGIC));
+	h.version = TSPBIN_VERSION;
+	h.byte_order = TSPBIN_BYTE_ORDER;
+	h.source_size = src.st_size;
+	h.source_hash = source;
+	h.hash = instanceHash(inst);
+	strcpy(h.name, (*inst).name);
+	h.dimension = n;
+	h.renumbered = ((*inst).orig != NULL);
+	h.has_dist = ((*inst).backend == DIST_MATRIX);
+	h.layout = (*inst).layout;
+	h.precision = (*inst).precision;
+	h.metric = (*inst).metric;
+
+	h.coords_offset = sizeof(TSPBinHeader);
+	pos = h.coords_offset + 2 * n * sizeof(double);
+
+	if(h.renumbered){
+		h.orig_offset = pos;
+		pos += n * sizeof(int);
+	}/* if */
+
+	block = ((*inst).precision == DIST_NINT) ? (const void*)(*inst).idist : ((*inst).precision == DIST_FLOAT) ? (const void*)(*inst).fdist : (const void*)(*inst).dist;
+
+	if(h.has_dist){
+		h.dist_offset = (pos + TSPBIN_PAGE - 1) / TSPBIN_PAGE * TSPBIN_PAGE;
+		h.dist_bytes = distEntries(n, (*inst).layout) * distEntrySize((*inst).precision);
+	}/* if */
+
+	cacheFileName((*set).input_file_name, name);
+	sprintf(temp, "%s%s.tmp", (*set).input_file_name, TSPBIN_EXTENSION);
+
+	if((file = fopen(temp, "wb")) == NULL)
+		return -1;
+
+	ok = fwrite(&h, sizeof(h), 1, file) == 1 && fwrite((*inst).x, sizeof(double), n, file) == n && fwrite((*inst).y, sizeof(double), n, file) == n;
+
+	if(ok && h.renumbered)
+		ok = fwrite((*inst).orig, sizeof(int), n, file) == n;
+
+	if(ok && h.has_dist){
+
+		for(; pos < h.dist_offset && ok; pos++)
+			ok = fputc(0, file) != EOF;
+
+		ok = ok && fwrite(block, 1, h.dist_bytes, file) == h.dist_bytes;
+
+	}/* if */
+
+	ok = !fclose(file) && ok;
+
+	if(!ok || rename(temp, name)){
+		remove(temp);
+		return -1;
+	}/* if */
+
+	return 0;
+
+}/* writeInstanceCache */
@@ -0,0 +1,57 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : cache.h
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "../settings/settings.h"
+#include "../../tsp.h"
+
+#define TSPBIN_MAGIC "TSPBIN"
+#define TSPBIN_VERSION 3 /* to be increased at every change of the layout below */
+#define TSPBIN_EXTENSION ".tspbin"
+#define TSPBIN_BYTE_ORDER 0x01020304u /* read back differently on a machine with another byte order */
+#define TSPBIN_PAGE 4096 /* the distance block starts at a multiple of it, so it is aligned once mapped */
+#define MAX_CACHE_NAME_SIZE (MAX_FILE_NAME_SIZE + sizeof(TSPBIN_EXTENSION) + sizeof(".tmp"))
+
+/*
+* The cache file is the header followed by the x coordinates, the y coordinates, the original ids (only if
+* renumbered) and, from dist_offset, the distance block exactly as it is in memory. All in the byte order of the
+* machine that wrote it.
+*/
+typedef struct {
+	char magic[8];			/* magic       := TSPBIN_MAGIC */
+	uint32_t version;		/* version     := TSPBIN_VERSION */
+	uint32_t byte_order;	/* byte_order  := TSPBIN_BYTE_ORDER */
+	uint64_t source_size;	/* source_size := size of the TSPLIB file the cache comes from */
+	uint64_t source_hash;	/* source_hash := sourceHash of the bytes of the TSPLIB file the cache comes from */
+	uint64_t hash;			/* hash        := instanceHash of the cached instance, it detects a damaged cache file */
+	char name[MAX_NAME_LENGTH];
+	int32_t dimension;
+	int32_t renumbered;		/* renumbered  := 1 if the nodes are renumbered along the Hilbert curve */
+	int32_t has_dist;		/* has_dist    := 1 if the distance block is stored */
+	int32_t layout;			/* layout, precision := DIST_LAYOUT and DIST_PRECISION of the distance block */
+	int32_t precision;
+	int32_t metric;			/* metric      := DIST_METRIC of the instance */
+	uint64_t coords_offset;	/* coords_offset := position of the x coordinates, the y ones follow */
+	uint64_t orig_offset;	/* orig_offset := position of the original ids, 0 if not renumbered */
+	uint64_t dist_offset;	/* dist_offset := position of the distance block, 0 if not stored */
+	uint64_t dist_bytes;	/* dist_bytes  := size of the distance block */
+} TSPBinHeader;
+
+uint64_t sourceHash(const void*, size_t);
+
+int fileHash(const char[], uint64_t*);
+
+uint64_t instanceHash(const TSPInstance*);
+
+void cacheFileName(const char[], char[]);
+
+int mapInstanceCache(const Settings*, TSPInstance*);
+
+int writeInstanceCache(const Settings*, const TSPInstance*, uint64_t);
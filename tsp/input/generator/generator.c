@@ -7,52 +7,199 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+#include <assert.h>
 
 #include "generator.h"
-#include "../../tsp.h"
+#include "../../utility/utility.h"
 
 /*
-* IP seed for the random generation
-* IP reset boolean indicating if the seed needs to be resetted
-* OP inst instance to random generate
+* IOP rng generator
+* IP centres centres of the clusters
+* IP ncentres number of $centres
+* IP sigma standard deviation of each coordinate around its centre
+* OP p point around a random centre
+* NB: the two coordinates are the two normal deviates of one Box-Muller transform
 */
-void generatePointsResetSeed(int seed, bool reset, TSPInstance* inst){
-	
-	int i;
+void clusteredPoint(RNG* rng, const Point2D* centres, int ncentres, double sigma, Point2D* p){
 
-	if(reset)
-		srand(seed);
+	const Point2D* c = &(centres[rngBelow(rng, ncentres)]);
+	double r = sigma * sqrt(-2.0 * log(1.0 - rngUniform(rng))), theta = GEN_TWO_PI * rngUniform(rng);
 
-    for(i = 0; i < (*inst).dimension; i++)
-        randomPoint(&((*inst).points[i]));
+	(*p).x = (*c).x + r * cos(theta);
+	(*p).y = (*c).y + r * sin(theta);
 
-}/* generatePoints */
+}/* clusteredPoint */
 
 /*
-* IP seed for the random generation
-* OP inst instance to random generate
+* IOP rng generator
+* IP i index of the point
+* IP side number of nodes of each side of the grid
+* OP p node i of the grid, row by row, moved at random by up to GEN_GRID_JITTER steps along each axis
 */
-void generatePoints(int seed, TSPInstance* inst){
+void gridPoint(RNG* rng, int i, int side, Point2D* p){
+
+	double step = MAX_RANDOM_VALUE / side;
+
+	(*p).x = (i % side + 0.5 + GEN_GRID_JITTER * (2.0 * rngUniform(rng) - 1.0)) * step;
+	(*p).y = (i / side + 0.5 + GEN_GRID_JITTER * (2.0 * rngUniform(rng) - 1.0)) * step;
+
+}/* gridPoint */
+
+/*
+* IOP arg GEN_CHUNK to generate
+* OR NULL
+* NB: pthread entry point
+*/
+void* generatePointsChunk(void* arg){
+
+	GEN_CHUNK* chunk = arg;
+	TSPInstance* inst = (*chunk).inst;
+	int b, i, last, n = (*inst).dimension, side = (int)ceil(sqrt(n));
+	double sigma = MAX_RANDOM_VALUE / sqrt(n);
+	RNG rng;
+
+	for(b = (*chunk).first; b < (*chunk).last; b++){
+
+		rng = (*chunk).streams[b];
+		last = ((long)(b + 1) * GEN_BLOCK_SIZE < n) ? (b + 1) * GEN_BLOCK_SIZE : n;
+
+		for(i = b * GEN_BLOCK_SIZE; i < last; i++)
+			if((*chunk).dist == GEN_CLUSTERED)
+				clusteredPoint(&rng, (*chunk).centres, (*chunk).ncentres, sigma, &((*inst).points[i]));
+			else if((*chunk).dist == GEN_GRID)
+				gridPoint(&rng, i, side, &((*inst).points[i]));
+			else
+				randomPoint(&rng, &((*inst).points[i]));
+
+	}/* for */
+
+	return NULL;
+
+}/* generatePointsChunk */
+
+/*
+* IP seed seed of the points
+* IP dist distribution of the points
+* IP nt number of threads
+* OP inst instance whose points are generated
+* NB: the points are split in blocks of GEN_BLOCK_SIZE, the block b is drawn from the stream b + 1 of $seed (the
+*	stream 0 draws the centres of the clusters). The blocks are split in equal chunks run by runChunks, so the
+*	points are the same whatever the number of threads is.
+*/
+void generatePointsThreads(uint64_t seed, GEN_DISTRIBUTION dist, int nt, TSPInstance* inst){
+
+	int b, t, n = (*inst).dimension, nb = (n + GEN_BLOCK_SIZE - 1) / GEN_BLOCK_SIZE;
+	int ncentres = (n / GEN_POINTS_PER_CLUSTER > 0) ? n / GEN_POINTS_PER_CLUSTER : 1;
+	Point2D* centres = NULL;
+	RNG rng, *streams;
+	GEN_CHUNK* chunks;
+
+	rngInit(seed, 0, &rng);
+
+	if(dist == GEN_CLUSTERED){
+
+		centres = malloc(ncentres * sizeof(Point2D));
+		assert(centres != NULL);
+
+		for(b = 0; b < ncentres; b++){
+			centres[b].x = MAX_RANDOM_VALUE * rngUniform(&rng);
+			centres[b].y = MAX_RANDOM_VALUE * rngUniform(&rng);
+		}/* for */
+
+		rngInit(seed, 0, &rng);
 
-	generatePointsResetSeed(seed, true, inst);
+	}/* if */
+
+	streams = malloc(nb * sizeof(RNG));
+	assert(streams != NULL);
+
+	/* one jump from a stream to the next, rngInit would jump from the stream 0 every time */
+	for(b = 0; b < nb; b++){
+		rngJump(&rng);
+		streams[b] = rng;
+	}/* for */
+
+	if(nt > nb)
+		nt = nb;
+
+	if(nt < 1)
+		nt = 1;
+
+	chunks = malloc(nt * sizeof(GEN_CHUNK));
+	assert(chunks != NULL);
+
+	for(t = 0; t < nt; t++){
+		chunks[t].inst = inst;
+		chunks[t].dist = dist;
+		chunks[t].streams = streams;
+		chunks[t].centres = centres;
+		chunks[t].ncentres = ncentres;
+		chunks[t].first = (int)((long)nb * t / nt);
+		chunks[t].last = (int)((long)nb * (t + 1) / nt);
+	}/* for */
+
+	runChunks(chunks, sizeof(GEN_CHUNK), nt, generatePointsChunk);
+
+	free(chunks);
+	free(streams);
+	free(centres);
+
+}/* generatePointsThreads */
+
+/*
+* IP seed seed of the points
+* IP dist distribution of the points
+* OP inst instance whose points are generated on all the available cores, see generatePointsThreads
+*/
+void generatePoints(uint64_t seed, GEN_DISTRIBUTION dist, TSPInstance* inst){
+
+	generatePointsThreads(seed, dist, get_hardware_concurrency(), inst);
 
 }/* generatePoints */
 
+/*
+ * IP set settings
+ * OP inst instance allocated for $set->n nodes, without the distance matrix if $set->od is true
+ */
+void allocGeneratedInst(const Settings* set, TSPInstance* inst){
+
+	if((*set).od)
+		allocInstBackend((*set).n, DIST_ON_THE_FLY, DIST_TRIANGULAR, (*set).dp, inst);
+	else
+		allocInstPrecision((*set).n, (*set).dp, inst);
+
+}/* allocGeneratedInst */
+
 /*
  * IP set settings
  * IP name of the instance
  * IP reset boolean indicating if the seed needs to be resetted
  * OP inst instance to random generate
  * This method assumes the instance to be already allocated
+ * NB: with $reset the points come from $set->seed and the random choices of the algorithms restart from it, otherwise
+ *	from a seed drawn from the calling thread (a new instance at each call)
  */
 void generateInstanceName(const Settings* set, bool reset, const char name[], TSPInstance* inst){
 
+	uint64_t seed = (*set).seed;
+
 	strcpy(inst->name, name);
 
-	generatePointsResetSeed((*set).seed, reset, inst);
+	if(reset)
+		rngSeed(seed);
+	else
+		seed = rngNext(rngThread());
+
+	generatePoints(seed, (*set).gd, inst);
 	
+	if((*set).hr)
+		renumberHilbert(inst);
+
 	computeDistances(inst);
 
+	computeCandidates((*set).nc, (*set).ck, inst);
+
 }/* generateInstance */
 
 /*
@@ -61,7 +208,7 @@ void generateInstanceName(const Settings* set, bool reset, const char name[], TS
  */
 void generateInstance(const Settings* set, TSPInstance* inst){
 
-    allocInst((*set).n, inst);
+    allocGeneratedInst(set, inst);
 
 	generateInstanceName(set, true, "RANDOM", inst);
 
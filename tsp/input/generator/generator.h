@@ -5,8 +5,37 @@
 * File     : generator.h
 */
 
+#pragma once
+
 #include "../settings/settings.h"
 #include "../../tsp.h"
+#include "../../utility/rng/rng.h"
+
+#define GEN_BLOCK_SIZE 4096 /* points drawn from the same stream, the blocks do not depend on the number of threads */
+#define GEN_POINTS_PER_CLUSTER 10 /* n / GEN_POINTS_PER_CLUSTER clusters, as DIMACS portcgen */
+#define GEN_GRID_JITTER 0.25 /* largest move of a point from its grid node, in grid steps */
+#define GEN_TWO_PI 6.283185307179586 /* M_PI is not C99 */
+
+typedef enum {
+	GEN_UNIFORM,		/* integer coordinates uniform in [0, MAX_RANDOM_VALUE]^2 (DIMACS portgen) */
+	GEN_CLUSTERED,		/* Gaussian clusters around centres uniform in the square (DIMACS portcgen) */
+	GEN_GRID			/* nodes of a square grid over the square, each moved at random by up to GEN_GRID_JITTER steps */
+} GEN_DISTRIBUTION;
+
+typedef struct {
+	TSPInstance* inst;		/* inst    := instance whose points are generated */
+	GEN_DISTRIBUTION dist;	/* dist    := distribution of the points */
+	const RNG* streams;		/* streams := streams[b] generator of the block b */
+	const Point2D* centres;	/* centres := centres of the clusters, GEN_CLUSTERED only */
+	int ncentres;			/* ncentres := number of $centres */
+	int first, last;		/* first, last := the chunk covers the blocks [first, last) */
+} GEN_CHUNK;
+
+void generatePointsThreads(uint64_t, GEN_DISTRIBUTION, int, TSPInstance*);
+
+void generatePoints(uint64_t, GEN_DISTRIBUTION, TSPInstance*);
+
+void allocGeneratedInst(const Settings*, TSPInstance*);
 
 void generateInstance(const Settings*, TSPInstance*);
 
@@ -5,32 +5,477 @@
 * File     : reader.c
 */
 
+#define _POSIX_C_SOURCE 200112L /* open, fstat, mmap */
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 #include "reader.h"
+#include "../cache/cache.h"
+
+/* Powers of ten exactly representable as double */
+static const double exactPow10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Values accepted by the header keywords */
+static const char* const typeNames[] = {"TSP", NULL};
+static const int typeValues[] = {0};
+static const char* const metricNames[] = {"EUC_2D", "CEIL_2D", "ATT", "GEO", "EXPLICIT", NULL};
+static const int metricValues[] = {METRIC_EUC_2D, METRIC_CEIL_2D, METRIC_ATT, METRIC_GEO, METRIC_EXPLICIT};
+/* the matrix is symmetric, so each column format lists the weights as the row format of the transpose */
+static const char* const formatNames[] = {"FULL_MATRIX", "UPPER_ROW", "LOWER_ROW", "UPPER_DIAG_ROW", "LOWER_DIAG_ROW",
+	"UPPER_COL", "LOWER_COL", "UPPER_DIAG_COL", "LOWER_DIAG_COL", NULL};
+static const int formatValues[] = {FULL_MATRIX, UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW, LOWER_DIAG_ROW,
+	LOWER_ROW, UPPER_ROW, LOWER_DIAG_ROW, UPPER_DIAG_ROW};
+
+/*
+* Position in a text that is not '\0' terminated, e.g. a mapped file.
+*/
+typedef struct {
+	const char* p;		/* p   := next character to read */
+	const char* end;	/* end := position after the last character */
+} TEXT_CURSOR;
+
+/*
+* IOP c cursor moved after the spaces and tabs, new lines excluded
+*/
+void skipBlanks(TEXT_CURSOR* c){
+
+	while((*c).p < (*c).end && (*(*c).p == ' ' || *(*c).p == '\t'))
+		(*c).p++;
+
+}/* skipBlanks */
+
+/*
+* IOP c cursor moved after any white space, new lines included
+*/
+void skipSpaces(TEXT_CURSOR* c){
+
+	while((*c).p < (*c).end && (*(*c).p == ' ' || *(*c).p == '\t' || *(*c).p == '\n' || *(*c).p == '\r'))
+		(*c).p++;
+
+}/* skipSpaces */
+
+/*
+* IOP c cursor moved at the beginning of the next line
+*/
+void skipLine(TEXT_CURSOR* c){
+
+	const char* nl;
+
+	if((*c).p >= (*c).end)
+		return;
+
+	nl = memchr((*c).p, '\n', (size_t)((*c).end - (*c).p));
+	(*c).p = (nl == NULL) ? (*c).end : nl + 1;
+
+}/* skipLine */
+
+/*
+* IOP c cursor moved after the next word
+*/
+void skipWord(TEXT_CURSOR* c){
+
+	skipSpaces(c);
+
+	while((*c).p < (*c).end && *(*c).p != ' ' && *(*c).p != '\t' && *(*c).p != '\n' && *(*c).p != '\r')
+		(*c).p++;
+
+}/* skipWord */
+
+/*
+* IOP c cursor moved after the keyword
+* OP keyword the keyword (letters, digits and '_'), truncated to MAX_KEYWORD_LENGTH - 1 characters
+*/
+void readKeyword(TEXT_CURSOR* c, char keyword[]){
+
+	int len = 0;
+
+	while((*c).p < (*c).end && (*(*c).p == '_' || (*(*c).p >= 'A' && *(*c).p <= 'Z') || (*(*c).p >= 'a' && *(*c).p <= 'z') || (*(*c).p >= '0' && *(*c).p <= '9'))){
+		if(len < MAX_KEYWORD_LENGTH - 1)
+			keyword[len++] = *(*c).p;
+		(*c).p++;
+	}/* while */
+
+	keyword[len] = '\0';
+
+}/* readKeyword */
+
+/*
+* IOP c cursor moved at the beginning of the next line
+* IP size size of $value
+* OP value rest of the line without the leading and trailing white space, truncated to $size - 1 characters
+*/
+void readValue(TEXT_CURSOR* c, int size, char value[]){
+
+	const char *first, *last;
+	int len;
+
+	skipBlanks(c);
+	first = (*c).p;
+	skipLine(c);
+	last = (*c).p;
+
+	while(last > first && (last[-1] == '\n' || last[-1] == '\r' || last[-1] == ' ' || last[-1] == '\t'))
+		last--;
+
+	len = (last - first < size - 1) ? last - first : size - 1;
+	memcpy(value, first, len);
+	value[len] = '\0';
+
+}/* readValue */
 
 /*
-* Removes space before ':' to homogenize TSPLIB file reading.
-* IOP line line of input file to read
+* IOP c cursor moved after the number
+* OP value the number read
+* OR true if a number was read
+* NB: up to 19 significant digits are accumulated into an integer, which is scaled by an exact power of ten when the
+*	result is exact (at most 2^53 and |exponent| <= 22, which covers TSPLIB coordinates); the other numbers are given to
+*	strtod. Either way the value is the correctly rounded one, the same fscanf would read.
 */
-void removeSpace(char* line){
-    
-    int i;
-    
-    for(i=0; i<strlen(line); i++){
+bool parseNumber(TEXT_CURSOR* c, double* value){
+
+	const char *p, *start;
+	uint64_t m = 0;
+	int digits = 0, exp10 = 0, e = 0;
+	bool neg = false, negexp = false, any = false, dropped = false;
+
+	skipSpaces(c);
+	p = start = (*c).p;
+
+	if(p < (*c).end && (*p == '-' || *p == '+'))
+		neg = (*p++ == '-');
+
+	for(; p < (*c).end && *p >= '0' && *p <= '9'; p++){
+		any = true;
+		if(m == 0 && *p == '0')
+			continue;
+		if(digits < 19){
+			m = m * 10 + (*p - '0');
+			digits++;
+		}else{
+			exp10++;
+			dropped |= (*p != '0');
+		}/* if */
+	}/* for */
+
+	if(p < (*c).end && *p == '.')
+		for(p++; p < (*c).end && *p >= '0' && *p <= '9'; p++){
+			any = true;
+			if(m == 0 && *p == '0'){
+				exp10--;
+				continue;
+			}/* if */
+			if(digits < 19){
+				m = m * 10 + (*p - '0');
+				digits++;
+				exp10--;
+			}else
+				dropped |= (*p != '0');
+		}/* for */
 
-        if(line[i] == ':')
-            break;
-        else if(line[i] == ' '){
-            strcpy(&line[i], &line[i+1]);
-            i--;
-        }
+	if(!any)
+		return false;
 
-    }
+	if(p < (*c).end && (*p == 'e' || *p == 'E')){
 
-}/* removeSpace */
+		const char* q = p + 1;
+
+		if(q < (*c).end && (*q == '-' || *q == '+'))
+			negexp = (*q++ == '-');
+
+		if(q < (*c).end && *q >= '0' && *q <= '9'){
+			for(p = q; p < (*c).end && *p >= '0' && *p <= '9'; p++)
+				if(e < 100000)
+					e = e * 10 + (*p - '0');
+			exp10 += negexp ? -e : e;
+		}/* if */
+
+	}/* if */
+
+	(*c).p = p;
+
+	if(!dropped && m <= ((uint64_t)1 << 53) && exp10 >= -22 && exp10 <= 22){
+		*value = (exp10 < 0) ? m / exactPow10[-exp10] : m * exactPow10[exp10];
+		*value = neg ? -*value : *value;
+		return true;
+	}/* if */
+
+	if(p - start < MAX_NUMBER_LENGTH){
+		char buffer[MAX_NUMBER_LENGTH];
+		memcpy(buffer, start, p - start);
+		buffer[p - start] = '\0';
+		*value = strtod(buffer, NULL);
+		return true;
+	}/* if */
+
+	return false;
+
+}/* parseNumber */
+
+/*
+* IOP c cursor moved at the beginning of the next line
+* IP names names of the values accepted, NULL terminated
+* IP values value of each name
+* OP value value of the name read
+* OR true if the name read is one of $names
+*/
+bool readEnumValue(TEXT_CURSOR* c, const char* const names[], const int values[], int* value){
+
+	char word[MAX_KEYWORD_LENGTH];
+	int i;
+
+	readValue(c, MAX_KEYWORD_LENGTH, word);
+
+	for(i = 0; names[i] != NULL; i++)
+		if(!strcmp(word, names[i])){
+			*value = values[i];
+			return true;
+		}/* if */
+
+	return false;
+
+}/* readEnumValue */
+
+/*
+* IP n number of nodes
+* IP metric metric of the instance
+* IP set settings
+* OP inst instance allocated for $n nodes with $metric
+* NB: an explicit instance always gets the matrix, whatever its size is, and its points are all (0, 0) unless a
+*	DISPLAY_DATA_SECTION follows
+*/
+void allocParsedInst(int n, DIST_METRIC metric, const Settings* set, TSPInstance* inst){
+
+	if(metric == METRIC_EXPLICIT){
+		allocInstBackend(n, DIST_MATRIX, DIST_TRIANGULAR, (*set).dp, inst);
+		memset((*inst).points, 0, n * sizeof(Point2D));
+	}else
+		allocInstPrecision(n, (*set).dp, inst);
+
+	(*inst).metric = metric;
+
+}/* allocParsedInst */
+
+/*
+* IOP c cursor moved after the coordinates
+* IOP inst instance whose points are read, "id x y" for each node
+* OR true if all the coordinates are read
+* NB: the nodes are numbered in the order they appear, the ids are skipped
+*/
+bool parseCoordinates(TEXT_CURSOR* c, TSPInstance* inst){
+
+	int i;
+
+	for(i = 0; i < (*inst).dimension; i++){
+
+		skipWord(c);
+
+		if(!parseNumber(c, &((*inst).points[i].x)) || !parseNumber(c, &((*inst).points[i].y)))
+			return false;
+
+	}/* for */
+
+	return true;
+
+}/* parseCoordinates */
+
+/*
+* IOP c cursor moved after the weights
+* IP format how the weights are listed
+* IOP inst explicit instance whose matrix is read
+* OR true if all the weights are read
+* NB: the weights are stored straight into the matrix with the instance precision, the diagonal is 0 whatever the
+*	file says. With LOWER_DIAG_ROW the matrix is written sequentially, as it is packed.
+*/
+bool parseEdgeWeights(TEXT_CURSOR* c, EDGE_WEIGHT_FORMAT format, TSPInstance* inst){
+
+	int i, j, first, last, n = (*inst).dimension;
+	double w;
+
+	for(i = 0; i < n; i++){
+
+		first = (format == UPPER_ROW) ? i + 1 : (format == UPPER_DIAG_ROW) ? i : 0;
+		last = (format == LOWER_ROW) ? i : (format == LOWER_DIAG_ROW) ? i + 1 : n;
+
+		setDist(distIndex(i, i, inst), 0, inst);
+
+		for(j = first; j < last; j++){
+
+			if(!parseNumber(c, &w))
+				return false;
+
+			if(j != i)
+				setDist(distIndex(i, j, inst), w, inst);
+
+		}/* for */
+
+	}/* for */
+
+	return true;
+
+}/* parseEdgeWeights */
+
+/*
+* IP text TSPLIB text, not '\0' terminated
+* IP len length of $text
+* IP set settings
+* OP inst tsp instance with the points (and the matrix if explicit) read, distances not computed
+* OR Result code (
+   0: success;
+   -2: missing or too small dimension, or malformed data sections;
+   -3: unsupported TYPE, EDGE_WEIGHT_TYPE or EDGE_WEIGHT_FORMAT;
+)
+* NB: the header is a sequence of "KEYWORD : value" lines (spaces around ':' are optional), unknown keywords are
+*	skipped. The instance is allocated at the first data section, when its metric is known. Nothing is copied or
+*	allocated besides the instance itself.
+*/
+int parseTSPLIB(const char* text, size_t len, const Settings* set, TSPInstance* inst){
+
+	TEXT_CURSOR c = { text, text + len };
+	char keyword[MAX_KEYWORD_LENGTH], name[MAX_NAME_LENGTH] = "";
+	int n = 0, type, metric = METRIC_EUC_2D, format = FULL_MATRIX, res = 0;
+	bool allocated = false, coords = false, weights = false;
+
+	while(!res){
+
+		skipSpaces(&c);
+
+		if(c.p >= c.end)
+			break;
+
+		readKeyword(&c, keyword);
+		skipBlanks(&c);
+
+		if(c.p < c.end && *c.p == ':')
+			c.p++;
+
+		if(!strcmp(keyword, "EOF"))
+			break;
+
+		if(!strcmp(keyword, "NAME"))
+			readValue(&c, MAX_NAME_LENGTH, name);
+		else if(!strcmp(keyword, "TYPE")){
+
+			if(!readEnumValue(&c, typeNames, typeValues, &type))
+				res = -3;
+
+		}else if(!strcmp(keyword, "EDGE_WEIGHT_TYPE")){
+
+			if(allocated || !readEnumValue(&c, metricNames, metricValues, &metric))
+				res = -3;
+
+		}else if(!strcmp(keyword, "EDGE_WEIGHT_FORMAT")){
+
+			if(!readEnumValue(&c, formatNames, formatValues, &format))
+				res = -3;
+
+		}else if(!strcmp(keyword, "DIMENSION")){
+
+			double d;
+
+			if(n > 0 || !parseNumber(&c, &d) || d <= 2 || d > INT32_MAX)
+				res = -2;
+			else
+				n = (int)d;
+
+			skipLine(&c);
+
+		}else if(!strcmp(keyword, "NODE_COORD_SECTION") || !strcmp(keyword, "DISPLAY_DATA_SECTION") || !strcmp(keyword, "EDGE_WEIGHT_SECTION")){
+
+			if(n == 0){
+				res = -2;
+				break;
+			}/* if */
+
+			if(!allocated){
+				allocParsedInst(n, metric, set, inst);
+				allocated = true;
+			}/* if */
+
+			if(keyword[0] != 'E')
+				res = (coords = parseCoordinates(&c, inst)) ? 0 : -2;
+			else if(metric != METRIC_EXPLICIT)
+				res = -3;
+			else
+				res = (weights = parseEdgeWeights(&c, format, inst)) ? 0 : -2;
+
+		}else
+			skipLine(&c); /* COMMENT, DISPLAY_DATA_TYPE, NODE_COORD_TYPE, ... */
+
+	}/* while */
+
+	if(!res && !(metric == METRIC_EXPLICIT ? weights : coords))
+		res = -2;
+
+	if(res){
+		if(allocated)
+			freeInst(inst);
+		return res;
+	}/* if */
+
+	strcpy((*inst).name, name);
+
+	return 0;
+
+}/* parseTSPLIB */
+
+/*
+* IP set settings
+* IF File $(set->input_file_name) to parse.
+* OP inst tsp instance with the points read, distances not computed
+* OP hash sourceHash of the parsed content of the file (see cache.h), not computed if NULL
+* OR Result code (
+   0: success;
+   -1: the file cannot be opened;
+   -2: missing or too small dimension, or malformed data sections;
+   -3: unsupported TYPE, EDGE_WEIGHT_TYPE or EDGE_WEIGHT_FORMAT;
+)
+* NB: the file is mapped and parsed in place
+*/
+int parseInstance(const Settings* set, TSPInstance* inst, uint64_t* hash){
+
+	struct stat st;
+	void* text;
+	int fd, res;
+
+	if((fd = open((*set).input_file_name, O_RDONLY)) == -1)
+		return -1;
+
+	if(fstat(fd, &st)){
+		close(fd);
+		return -1;
+	}/* if */
+
+	if(st.st_size == 0){
+		close(fd);
+		return -2;
+	}/* if */
+
+	text = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if(text == MAP_FAILED)
+		return -1;
+
+	res = parseTSPLIB(text, st.st_size, set, inst);
+
+	if(!res && hash != NULL)
+		*hash = sourceHash(text, st.st_size);
+
+	munmap(text, st.st_size);
+
+	return res;
+
+}/* parseInstance */
 
 /*
 * IP set settings
@@ -38,54 +483,42 @@ void removeSpace(char* line){
 * OP inst tsp instance
 * OR Result code (
    0: success;
-   1: error;
+   -1: the file cannot be opened;
+   -2: missing or too small dimension, or malformed data sections;
+   -3: unsupported TYPE, EDGE_WEIGHT_TYPE or EDGE_WEIGHT_FORMAT;
 )
+* NB: a valid cache file $(set->input_file_name).tspbin is preferred to the TSPLIB file, otherwise it is (re)written
+*	after the distances are computed (see cache.h) unless $set->nw is true. A notice tells whether it was written.
 * resource: http://comopt.ifi.uni-heidelberg.de/software/TSPLIB95/tsp/
 */
 int readInstance(const Settings* set, TSPInstance* inst){
-    
-	int i, dummy;
-    char line[MAX_LINE_LENGTH];
-
-    FILE *file = fopen(set->input_file_name, "r");
-
-    if (file == NULL)
-        return -1;
-
-    while(fgets(line, MAX_LINE_LENGTH, file)){
-        
-        int n;
-        
-        removeSpace(line);
-
-        if(!strncmp(line, "EOF", 3)){
-            break;
-        }
-
-        if(strstr(line, "NAME: ") != NULL){
-            int len = strlen(line);
-            line[len-1] = '\0';
-            strcpy(inst->name, &line[sizeof("NAME: ") - 1]);
-        }
-        else if(strstr(line, "DIMENSION: ") != NULL){
-            n = strtol(&line[sizeof("DIMENSION: ") - 1], NULL, 10);
-            if(n <= 2){
-                fclose(file);
-                return -2;
-            }
-            
-            allocInst(n, inst);
-        }
-        else if(strstr(line, "NODE_COORD_SECTION") != NULL){
-            for(i=0; i<inst->dimension; i++)
-                fscanf(file, "%d %lf %lf", &dummy, &((inst->points[i]).x), &((inst->points[i]).y));
-        }
-    }	
-
-    fclose(file);
+
+	int res;
+	uint64_t source;
+
+	if(!mapInstanceCache(set, inst)){
+		computeDistances(inst);
+		computeCandidates((*set).nc, (*set).ck, inst);
+		return 0;
+	}/* if */
+
+	if((res = parseInstance(set, inst, &source)))
+		return res;
+
+	if((*set).hr)
+		renumberHilbert(inst);
 
 	computeDistances(inst);
 
-    return 0;  
+	if(!(*set).nw){
+		if(writeInstanceCache(set, inst, source))
+			printf("Notice: the cache file %s%s cannot be written\n", (*set).input_file_name, TSPBIN_EXTENSION);
+		else
+			printf("Notice: cache file %s%s written, use -w to skip it\n", (*set).input_file_name, TSPBIN_EXTENSION);
+	}/* if */
+
+	computeCandidates((*set).nc, (*set).ck, inst);
+
+    return 0;
 
 }/* readInstance */
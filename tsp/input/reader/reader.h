@@ -5,9 +5,25 @@
 * File     : reader.h
 */
 
+#include <stdint.h>
+
 #include "../settings/settings.h"
 #include "../../tsp.h"
 
-#define MAX_LINE_LENGTH 133
+#define MAX_KEYWORD_LENGTH 32
+#define MAX_NUMBER_LENGTH 64 /* longer numbers are rejected */
+
+/* How the weights of an EDGE_WEIGHT_SECTION are listed, row by row */
+typedef enum {
+	FULL_MATRIX,		/* the whole matrix */
+	UPPER_ROW,			/* row i lists the nodes i + 1..n - 1 */
+	LOWER_ROW,			/* row i lists the nodes 0..i - 1 */
+	UPPER_DIAG_ROW,		/* row i lists the nodes i..n - 1 */
+	LOWER_DIAG_ROW		/* row i lists the nodes 0..i */
+} EDGE_WEIGHT_FORMAT;
+
+int parseTSPLIB(const char*, size_t, const Settings*, TSPInstance*);
+
+int parseInstance(const Settings*, TSPInstance*, uint64_t*);
 
 int readInstance(const Settings*, TSPInstance*);
@@ -16,6 +16,14 @@
 
 #define DEFAULT_TIME_LIMIT 30 /* 30 s */
 #define DEFAULT_SEED 2060685 + 2088626
+#define DEFAULT_DIST_PRECISION 0 /* DIST_DOUBLE */
+#define MAX_DIST_PRECISION 2 /* DIST_NINT */
+#define DEFAULT_CANDIDATES 10
+#define DEFAULT_CAND_KIND 0 /* CAND_KNN */
+#define MAX_CAND_KIND 2 /* CAND_DELAUNAY */
+#define DEFAULT_DISTRIBUTION 0 /* GEN_UNIFORM */
+#define MAX_DISTRIBUTION 2 /* GEN_GRID */
+#define FSM_FREE_SYMBOL ALPHABET_CARDINALITY /* out of the alphabet: option accepted without moving the validator FSM */
 
 static struct option long_options[] = {
 		/* {name, kind_arg, flag, key} */
@@ -23,6 +31,13 @@ static struct option long_options[] = {
         {"file", required_argument, 0, 'f'},
         {"nodes", required_argument, 0, 'n'},
         {"tl", required_argument, 0, 't'},
+        {"precision", required_argument, 0, 'p'},
+        {"candidates", required_argument, 0, 'k'},
+        {"candkind", required_argument, 0, 'c'},
+        {"renumber", no_argument, 0, 'r'},
+        {"distribution", required_argument, 0, 'g'},
+        {"ondemand", no_argument, 0, 'd'},
+        {"nocache", no_argument, 0, 'w'},
         {"help", no_argument, 0, 'h'},
         {0, 0, 0, 0} /* End of options */
 };
@@ -39,6 +54,13 @@ void help(void){
     printf("\t-tl         <timelimit_value>\tset an execution time limit (in seconds) - default 30s\n");
     printf("\t-v          <\\>\t\t\tset the verbose flag to true\n");
 	printf("\t-n, --nodes <number_of_nodes>\tnumber of nodes for the random instance\n");
+	printf("\t-p, --precision <code>\t\tprecision of the stored distances: 0 double (default), 1 float, 2 TSPLIB nint\n");
+	printf("\t-k, --candidates <k>\t\tcandidate neighbours of each node for the local searches, 0 to scan all the moves - default %d\n", DEFAULT_CANDIDATES);
+	printf("\t-c, --candkind <code>\t\tcandidate neighbours: 0 k-nearest (default), 1 quadrant-balanced, 2 Delaunay neighbours first\n");
+	printf("\t-r, --renumber\t\t\trenumber the nodes along a Hilbert curve (the tours are printed with the original ids)\n");
+	printf("\t-g, --distribution <code>\tpoints of the random instance: 0 uniform (default), 1 Gaussian clusters, 2 perturbed grid\n");
+	printf("\t-d, --ondemand\t\t\tdo not precompute the distances of the random instance, compute them on demand\n");
+	printf("\t-w, --nocache\t\t\tdo not write the cache file <file_name>.tspbin with the distances of the input file\n");
     printf("\t-h  --help\t\t\tto reach this section\n");
     printf("\n");
 
@@ -61,6 +83,13 @@ void init(Settings* set){
     set->n = 0;
     set->seed = DEFAULT_SEED;
     set->tl = DEFAULT_TIME_LIMIT;
+    set->dp = DEFAULT_DIST_PRECISION;
+    set->nc = DEFAULT_CANDIDATES;
+    set->ck = DEFAULT_CAND_KIND;
+    set->gd = DEFAULT_DISTRIBUTION;
+    set->hr = false;
+    set->od = false;
+    set->nw = false;
     set->v = false;
 
 }/* init */
@@ -79,6 +108,16 @@ void printSettings(const Settings* set){
 	if(set->n)
     	printf("\tnumber of nodes: %d\n", set->n);
     printf("\ttime limit: %lf\n", set->tl);
+    printf("\tdistances precision: %d\n", set->dp);
+    printf("\tcandidate neighbours: %d\n", set->nc);
+    printf("\tcandidate neighbours kind: %d\n", set->ck);
+    if(set->n)
+        printf("\tpoints distribution: %d\n", set->gd);
+    printBool("\tHilbert renumbering: ", set->hr);
+    if(set->n)
+        printBool("\tdistances on demand: ", set->od);
+    if(!set->n)
+        printBool("\tno cache writing: ", set->nw);
     printBool("\tverbose: ", set->v);
 	printf("\n");
 
@@ -89,7 +128,8 @@ void printSettings(const Settings* set){
 * OP set settings for the program execution
 * OR char representing the readed symbol associated to the setted option in the switch-case list,
 *    the value 0 has a special meaning, if zero is returned then there was some problem with
-*    the option (missing required or unconsistent value)
+*    the option (missing required or unconsistent value), FSM_FREE_SYMBOL is returned by the
+*    options that can be combined with any configuration and do not move the validator
 */
 char setOption(int opt_val, Settings* set){
 
@@ -130,6 +170,42 @@ char setOption(int opt_val, Settings* set){
             (*set).v = true;
             return 6;
 
+        case 'p':
+            (*set).dp = strtol(optarg, NULL, 10);
+            if((*set).dp < 0 || (*set).dp > MAX_DIST_PRECISION)
+                return 0;
+            return FSM_FREE_SYMBOL;
+
+        case 'k':
+            (*set).nc = strtol(optarg, NULL, 10);
+            if((*set).nc < 0)
+                return 0;
+            return FSM_FREE_SYMBOL;
+
+        case 'c':
+            (*set).ck = strtol(optarg, NULL, 10);
+            if((*set).ck < 0 || (*set).ck > MAX_CAND_KIND)
+                return 0;
+            return FSM_FREE_SYMBOL;
+
+        case 'r':
+            (*set).hr = true;
+            return FSM_FREE_SYMBOL;
+
+        case 'g':
+            (*set).gd = strtol(optarg, NULL, 10);
+            if((*set).gd < 0 || (*set).gd > MAX_DISTRIBUTION)
+                return 0;
+            return FSM_FREE_SYMBOL;
+
+        case 'd':
+            (*set).od = true;
+            return FSM_FREE_SYMBOL;
+
+        case 'w':
+            (*set).nw = true;
+            return FSM_FREE_SYMBOL;
+
         default:
             printf("Unrecognized option: type 'main -h' or 'main --help' to see the options\n");
             return 0;
@@ -145,6 +221,13 @@ char setOption(int opt_val, Settings* set){
 * IP argv[] -tl       	: set an execution time limit (in seconds)
 * IP argv[] -v        	: set the verbose flag at true
 * IP argv[] -n, --nodes	: number of nodes for the random instance
+* IP argv[] -p, --precision	: precision of the stored distances
+* IP argv[] -k, --candidates	: candidate neighbours of each node
+* IP argv[] -c, --candkind	: how the candidate neighbours are chosen
+* IP argv[] -r, --renumber	: renumber the nodes along a Hilbert curve
+* IP argv[] -g, --distribution	: distribution of the points of the random instance
+* IP argv[] -d, --ondemand	: compute the distances of the random instance on demand
+* IP argv[] -w, --nocache	: do not write the cache file of the input file
 * IP argv[] -h  --help	: to reach the help section
 * OP set settings for the program execution
 * OR CONF (
@@ -157,12 +240,14 @@ char setOption(int opt_val, Settings* set){
 CONF parseCMDLine(int argc, char* const* argv, Settings* set){
     
 	int opt_indx, opt_val;
+    char symbol;
     FSM_STATES curr = START;
 
     init(set);
 
-    while((opt_val = getopt_long_only(argc, argv, ":f:s:n:hv", long_options, &opt_indx)) != EOF)
-        curr = delta(curr, setOption(opt_val, set));
+    while((opt_val = getopt_long_only(argc, argv, ":f:s:n:p:k:c:g:rdwhv", long_options, &opt_indx)) != EOF)
+        if((symbol = setOption(opt_val, set)) != FSM_FREE_SYMBOL)
+            curr = delta(curr, symbol);
 
     if(optopt) /* if the library recognize an error stores the option character into the variable optopt */
         printf("\n");
@@ -189,6 +274,13 @@ void cpSet(const Settings* source, Settings* destination){
     (*destination).n = (*source).n;
     (*destination).seed = (*source).seed;
     (*destination).tl = (*source).tl;
+    (*destination).dp = (*source).dp;
+    (*destination).nc = (*source).nc;
+    (*destination).ck = (*source).ck;
+    (*destination).gd = (*source).gd;
+    (*destination).hr = (*source).hr;
+    (*destination).od = (*source).od;
+    (*destination).nw = (*source).nw;
     (*destination).v = (*source).v;
 
 }/* cpSet */
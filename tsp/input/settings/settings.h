@@ -13,12 +13,19 @@
 typedef struct{
 
     char input_file_name[MAX_FILE_NAME_SIZE];
-    int n, seed;
+    int n, seed, dp, nc, ck, gd;
 	double tl;
-    bool v;
+    bool v, hr, od, nw;
     /* n    := number of nodes for the random instance */
     /* tl   := execution time limit (in seconds) */
     /* seed := seed used for random generation */
+    /* dp   := precision of the stored distances, a DIST_PRECISION code (see tsp.h) */
+    /* nc   := number of candidate neighbours of each node used by the local searches, 0 to scan all the moves */
+    /* ck   := how the candidate neighbours are chosen, a CAND_KIND code (see tsp.h) */
+    /* gd   := distribution of the points of the random instance, a GEN_DISTRIBUTION code (see generator.h) */
+    /* hr   := renumber the nodes along a Hilbert curve, true or false */
+    /* od   := compute the distances of the random instance on demand instead of precomputing them, true or false */
+    /* nw   := do not write the cache file of the input file (see cache.h), true or false */
     /* v    := verbosity, true or false */
 	
 } Settings;
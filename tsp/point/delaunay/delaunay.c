@@ -0,0 +1,618 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : delaunay.c
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <assert.h>
+
+#include "delaunay.h"
+#include "../../utility/utility.h"
+
+/*
+* Sweep-hull triangulation (the one of the Delaunator library): the points are inserted by increasing distance from the
+* circumcircle of a seed triangle, so each new point lies outside the current convex hull and is joined to the hull edges
+* it sees, then the Delaunay condition is restored by edge flips. Triangles are kept as half-edges: the half-edge e goes
+* from tri[e] to tri[next(e)] and half[e] is the opposite one in the adjacent triangle (-1 on the hull).
+*/
+typedef struct {
+	int n;
+	const double *x, *y;
+	double cx, cy;			/* circumcenter of the seed triangle */
+	int* tri;				/* vertices of the half-edges */
+	int* half;				/* opposite half-edges */
+	int nhalf;				/* half-edges in use, 3 * triangles */
+	int *hullPrev, *hullNext, *hullTri;	/* hull as a circular list of points, hullTri[i] half-edge from i along the hull */
+	int* hullHash;			/* hull points bucketed by the angle around (cx, cy), -1 if none */
+	int hashSize;
+	int hullStart;
+	int* ids;				/* insertion order */
+	double* key;			/* sort key of the points */
+	int* ea;				/* ea, eb := edges found */
+	int* eb;
+	int nedges;
+} DTBuilder;
+
+/*
+* OR > 0 if a, b, c are counterclockwise, < 0 if clockwise, 0 if collinear
+*/
+double dtOrient(double ax, double ay, double bx, double by, double cx, double cy){
+	return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}/* dtOrient */
+
+/*
+* OR true if p lies strictly inside the circumcircle of the counterclockwise triangle a, b, c
+*/
+bool dtInCircle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py){
+
+	double dx = ax - px, dy = ay - py, ex = bx - px, ey = by - py, fx = cx - px, fy = cy - py;
+	double ap = dx * dx + dy * dy, bp = ex * ex + ey * ey, cp = fx * fx + fy * fy;
+
+	return dx * (ey * cp - bp * fy) - dy * (ex * cp - bp * fx) + ap * (ex * fy - ey * fx) > 0;
+
+}/* dtInCircle */
+
+/*
+* OR squared circumradius of the triangle a, b, c, +inf or NaN if they are collinear
+*/
+double dtCircumradius2(double ax, double ay, double bx, double by, double cx, double cy){
+
+	double dx = bx - ax, dy = by - ay, ex = cx - ax, ey = cy - ay;
+	double bl = dx * dx + dy * dy, cl = ex * ex + ey * ey, d = 0.5 / (dx * ey - dy * ex);
+	double x = (ey * bl - dy * cl) * d, y = (dx * cl - ex * bl) * d;
+
+	return x * x + y * y;
+
+}/* dtCircumradius2 */
+
+/*
+* OP ox, oy circumcenter of the triangle a, b, c
+*/
+void dtCircumcenter(double ax, double ay, double bx, double by, double cx, double cy, double* ox, double* oy){
+
+	double dx = bx - ax, dy = by - ay, ex = cx - ax, ey = cy - ay;
+	double bl = dx * dx + dy * dy, cl = ex * ex + ey * ey, d = 0.5 / (dx * ey - dy * ex);
+
+	*ox = ax + (ey * bl - dy * cl) * d;
+	*oy = ay + (dx * cl - ex * bl) * d;
+
+}/* dtCircumcenter */
+
+/*
+* IP b builder
+* IP i point index
+* OR bucket of the hull hash of the point i, monotone in its angle around the seed circumcenter
+*/
+int dtHashKey(const DTBuilder* b, int i){
+
+	double dx = (*b).x[i] - (*b).cx, dy = (*b).y[i] - (*b).cy, p, angle;
+
+	if(dx == 0 && dy == 0)
+		return 0;
+
+	p = dx / (fabs(dx) + fabs(dy));
+	angle = (dy > 0 ? 3 - p : 1 + p) / 4; /* pseudo-angle in [0, 1] */
+
+	return (int)floor(angle * (*b).hashSize) % (*b).hashSize;
+
+}/* dtHashKey */
+
+/*
+* IP b builder
+* IP i point index
+* IP j point index
+* OR true if i comes before j: smaller key, then smaller x, y and index, so that equal points are consecutive
+*/
+bool dtBefore(const DTBuilder* b, int i, int j){
+
+	if((*b).key[i] != (*b).key[j])
+		return (*b).key[i] < (*b).key[j];
+
+	if((*b).x[i] != (*b).x[j])
+		return (*b).x[i] < (*b).x[j];
+
+	if((*b).y[i] != (*b).y[j])
+		return (*b).y[i] < (*b).y[j];
+
+	return i < j;
+
+}/* dtBefore */
+
+/*
+* IP b builder
+* IP lo first position
+* IP hi last position
+* IOP v points sorted in v[lo..hi] by dtBefore
+*/
+void dtSort(const DTBuilder* b, int lo, int hi, int* v){
+
+	int i, j;
+
+	while(hi - lo > 16){
+
+		int pivot = v[lo + (hi - lo) / 2];
+
+		i = lo;
+		j = hi;
+
+		while(i <= j){
+
+			while(dtBefore(b, v[i], pivot))
+				i++;
+
+			while(dtBefore(b, pivot, v[j]))
+				j--;
+
+			if(i <= j)
+				swapInt(&(v[i++]), &(v[j--]));
+
+		}/* while */
+
+		/* recursion on the smaller part, so that the stack stays O(log n) */
+		if(j - lo < hi - i){
+			dtSort(b, lo, j, v);
+			lo = i;
+		}else{
+			dtSort(b, i, hi, v);
+			hi = j;
+		}/* if */
+
+	}/* while */
+
+	for(i = lo + 1; i <= hi; i++)
+		for(j = i; j > lo && dtBefore(b, v[j], v[j - 1]); j--)
+			swapInt(&(v[j]), &(v[j - 1]));
+
+}/* dtSort */
+
+/*
+* IP a point index
+* IP c point index
+* IOP b builder where the edge (a, c) is recorded
+*/
+void dtAddEdge(int a, int c, DTBuilder* b){
+
+	(*b).ea[(*b).nedges] = a;
+	(*b).eb[(*b).nedges++] = c;
+
+}/* dtAddEdge */
+
+/*
+* IP e half-edge
+* IP o opposite half-edge, -1 if none
+* IOP b builder
+*/
+void dtLink(int e, int o, DTBuilder* b){
+
+	(*b).half[e] = o;
+
+	if(o != -1)
+		(*b).half[o] = e;
+
+}/* dtLink */
+
+/*
+* IP i0, i1, i2 vertices of the new triangle, counterclockwise
+* IP a, c, d half-edges opposite to i0->i1, i1->i2, i2->i0, -1 if none
+* IOP b builder
+* OR first half-edge of the new triangle
+*/
+int dtAddTriangle(int i0, int i1, int i2, int a, int c, int d, DTBuilder* b){
+
+	int t = (*b).nhalf;
+
+	(*b).tri[t] = i0;
+	(*b).tri[t + 1] = i1;
+	(*b).tri[t + 2] = i2;
+
+	dtLink(t, a, b);
+	dtLink(t + 1, c, b);
+	dtLink(t + 2, d, b);
+
+	(*b).nhalf += 3;
+
+	return t;
+
+}/* dtAddTriangle */
+
+/*
+* IP a half-edge to check
+* IOP b builder, the edge a and the ones behind it are flipped until they satisfy the Delaunay condition
+* OR the half-edge that precedes the last one checked, the hull edge leaving the point just inserted
+*
+*           pl                    pl
+*          /||\                  /  \
+*       al/ || \bl            al/    \a
+*        /  ||  \              /      \
+*       /  a||o  \    flip    /___ar___\
+*     p0\   ||   /p1   =>   p0\---bl---/p1
+*        \  ||  /              \      /
+*       ar\ || /br             o\    /br
+*          \||/                  \  /
+*           pr                    pr
+*/
+int dtLegalize(int a, DTBuilder* b){
+
+	int stack[DELAUNAY_EDGE_STACK], top = 0, ar = 0;
+
+	while(true){
+
+		int o = (*b).half[a], a0 = a - a % 3;
+
+		ar = a0 + (a + 2) % 3;
+
+		if(o == -1){ /* hull edge */
+
+			if(top == 0)
+				break;
+
+			a = stack[--top];
+			continue;
+
+		}/* if */
+
+		int o0 = o - o % 3, al = a0 + (a + 1) % 3, bl = o0 + (o + 2) % 3;
+		int p0 = (*b).tri[ar], pr = (*b).tri[a], pl = (*b).tri[al], p1 = (*b).tri[bl];
+
+		if(dtInCircle((*b).x[p0], (*b).y[p0], (*b).x[pr], (*b).y[pr], (*b).x[pl], (*b).y[pl], (*b).x[p1], (*b).y[p1])){
+
+			int hbl = (*b).half[bl];
+
+			(*b).tri[a] = p1;
+			(*b).tri[o] = p0;
+
+			/* the flipped edge was on the hull on the other side (rare), fix its reference */
+			if(hbl == -1){
+				int e = (*b).hullStart;
+				do{
+					if((*b).hullTri[e] == bl){
+						(*b).hullTri[e] = a;
+						break;
+					}/* if */
+					e = (*b).hullPrev[e];
+				}while(e != (*b).hullStart);
+			}/* if */
+
+			dtLink(a, hbl, b);
+			dtLink(o, (*b).half[ar], b);
+			dtLink(ar, bl, b);
+
+			if(top < DELAUNAY_EDGE_STACK)
+				stack[top++] = o0 + (o + 1) % 3;
+
+		}else{
+
+			if(top == 0)
+				break;
+
+			a = stack[--top];
+
+		}/* if */
+
+	}/* while */
+
+	return ar;
+
+}/* dtLegalize */
+
+/*
+* IP i0 first point of the line
+* IP i1 second point of the line, -1 if all the points are equal
+* IOP b builder, the points are chained in their order along the line
+*/
+void dtChain(int i0, int i1, DTBuilder* b){
+
+	int k;
+
+	for(k = 0; k < (*b).n; k++)
+		(*b).key[k] = (i1 == -1) ? 0 : ((*b).x[k] - (*b).x[i0]) * ((*b).x[i1] - (*b).x[i0]) + ((*b).y[k] - (*b).y[i0]) * ((*b).y[i1] - (*b).y[i0]);
+
+	dtSort(b, 0, (*b).n - 1, (*b).ids);
+
+	for(k = 1; k < (*b).n; k++)
+		dtAddEdge((*b).ids[k - 1], (*b).ids[k], b);
+
+}/* dtChain */
+
+/*
+* IP i0, i1, i2 seed triangle, counterclockwise
+* IOP b builder, the points are triangulated
+*/
+void dtSweep(int i0, int i1, int i2, DTBuilder* b){
+
+	int k, e, q, t, nx, prev = -1;
+
+	dtCircumcenter((*b).x[i0], (*b).y[i0], (*b).x[i1], (*b).y[i1], (*b).x[i2], (*b).y[i2], &((*b).cx), &((*b).cy));
+
+	for(k = 0; k < (*b).n; k++){
+		double dx = (*b).x[k] - (*b).cx, dy = (*b).y[k] - (*b).cy;
+		(*b).key[k] = dx * dx + dy * dy;
+	}/* for */
+
+	dtSort(b, 0, (*b).n - 1, (*b).ids);
+
+	(*b).hullStart = i0;
+
+	(*b).hullNext[i0] = (*b).hullPrev[i2] = i1;
+	(*b).hullNext[i1] = (*b).hullPrev[i0] = i2;
+	(*b).hullNext[i2] = (*b).hullPrev[i1] = i0;
+
+	(*b).hullTri[i0] = 0;
+	(*b).hullTri[i1] = 1;
+	(*b).hullTri[i2] = 2;
+
+	for(k = 0; k < (*b).hashSize; k++)
+		(*b).hullHash[k] = -1;
+
+	(*b).hullHash[dtHashKey(b, i0)] = i0;
+	(*b).hullHash[dtHashKey(b, i1)] = i1;
+	(*b).hullHash[dtHashKey(b, i2)] = i2;
+
+	dtAddTriangle(i0, i1, i2, -1, -1, -1, b);
+
+	for(k = 0; k < (*b).n; k++){
+
+		int i = (*b).ids[k], start = 0, j, key;
+
+		/* equal points are consecutive: the copies are only joined to the first one */
+		if(prev != -1 && (*b).x[i] == (*b).x[prev] && (*b).y[i] == (*b).y[prev]){
+			dtAddEdge(prev, i, b);
+			continue;
+		}/* if */
+
+		prev = i;
+
+		if(i == i0 || i == i1 || i == i2)
+			continue;
+
+		/* a hull point close in angle, then the first hull edge visible from i */
+		for(j = 0, key = dtHashKey(b, i); j < (*b).hashSize; j++){
+			start = (*b).hullHash[(key + j) % (*b).hashSize];
+			if(start != -1 && start != (*b).hullNext[start])
+				break;
+		}/* for */
+
+		start = (*b).hullPrev[start];
+		e = start;
+
+		while(q = (*b).hullNext[e], dtOrient((*b).x[e], (*b).y[e], (*b).x[q], (*b).y[q], (*b).x[i], (*b).y[i]) >= 0){
+			e = q;
+			if(e == start){
+				e = -1;
+				break;
+			}/* if */
+		}/* while */
+
+		if(e == -1) /* numerically on the hull, left out */
+			continue;
+
+		t = dtAddTriangle(e, i, (*b).hullNext[e], -1, -1, (*b).hullTri[e], b);
+
+		(*b).hullTri[i] = dtLegalize(t + 2, b);
+		(*b).hullTri[e] = t;
+
+		/* forward along the hull */
+		nx = (*b).hullNext[e];
+		while(q = (*b).hullNext[nx], dtOrient((*b).x[nx], (*b).y[nx], (*b).x[q], (*b).y[q], (*b).x[i], (*b).y[i]) < 0){
+			t = dtAddTriangle(nx, i, q, (*b).hullTri[i], -1, (*b).hullTri[nx], b);
+			(*b).hullTri[i] = dtLegalize(t + 2, b);
+			(*b).hullNext[nx] = nx; /* removed from the hull */
+			nx = q;
+		}/* while */
+
+		/* backward along the hull */
+		if(e == start)
+			while(q = (*b).hullPrev[e], dtOrient((*b).x[q], (*b).y[q], (*b).x[e], (*b).y[e], (*b).x[i], (*b).y[i]) < 0){
+				t = dtAddTriangle(q, i, e, -1, (*b).hullTri[e], (*b).hullTri[q], b);
+				dtLegalize(t + 2, b);
+				(*b).hullTri[q] = t;
+				(*b).hullNext[e] = e; /* removed from the hull */
+				e = q;
+			}/* while */
+
+		(*b).hullStart = (*b).hullPrev[i] = e;
+		(*b).hullNext[e] = (*b).hullPrev[nx] = i;
+		(*b).hullNext[i] = nx;
+
+		(*b).hullHash[dtHashKey(b, i)] = i;
+		(*b).hullHash[dtHashKey(b, e)] = e;
+
+	}/* for */
+
+	/* each edge once, from the half-edge with the larger index (or the only one) */
+	for(e = 0; e < (*b).nhalf; e++)
+		if((*b).half[e] < e)
+			dtAddEdge((*b).tri[e], (*b).tri[e - e % 3 + (e + 1) % 3], b);
+
+}/* dtSweep */
+
+/*
+* IOP b builder whose edges become the adjacency lists of $g
+* OP g graph
+*/
+void dtAdjacency(DTBuilder* b, DelaunayGraph* g){
+
+	int i, k, *fill;
+
+	(*g).nedges = (*b).nedges;
+
+	(*g).first = calloc((*b).n + 1, sizeof(int));
+	assert((*g).first != NULL);
+
+	(*g).adj = malloc((2 * (size_t)(*b).nedges + 1) * sizeof(int));
+	assert((*g).adj != NULL);
+
+	for(k = 0; k < (*b).nedges; k++){
+		(*g).first[(*b).ea[k] + 1]++;
+		(*g).first[(*b).eb[k] + 1]++;
+	}/* for */
+
+	for(i = 0; i < (*b).n; i++)
+		(*g).first[i + 1] += (*g).first[i];
+
+	fill = malloc(((*b).n + 1) * sizeof(int));
+	assert(fill != NULL);
+
+	for(i = 0; i < (*b).n; i++)
+		fill[i] = (*g).first[i];
+
+	for(k = 0; k < (*b).nedges; k++){
+		(*g).adj[fill[(*b).ea[k]]++] = (*b).eb[k];
+		(*g).adj[fill[(*b).eb[k]]++] = (*b).ea[k];
+	}/* for */
+
+	free(fill);
+
+	/* nearest first */
+	for(i = 0; i < (*b).n; i++){
+
+		for(k = (*g).first[i]; k < (*g).first[i + 1]; k++){
+			int j = (*g).adj[k];
+			double dx = (*b).x[j] - (*b).x[i], dy = (*b).y[j] - (*b).y[i];
+			(*b).key[j] = dx * dx + dy * dy;
+		}/* for */
+
+		dtSort(b, (*g).first[i], (*g).first[i + 1] - 1, (*g).adj);
+
+	}/* for */
+
+}/* dtAdjacency */
+
+/*
+* IP n number of points
+* IP x x coordinates of the points
+* IP y y coordinates of the points
+* OP g Delaunay triangulation of the points and its edges, O(n log n)
+* NB: equal points are joined only to one copy, which is the one triangulated. If all the points are collinear there
+*	are no triangles and the edges chain them along the line.
+*/
+void buildDelaunay(int n, const double* x, const double* y, DelaunayGraph* g){
+
+	DTBuilder b;
+	int i, i0 = -1, i1 = -1, i2 = -1;
+	double minx, miny, maxx, maxy, best;
+
+	(*g).n = n;
+	(*g).ntri = 0;
+
+	b.n = n;
+	b.x = x;
+	b.y = y;
+	b.nhalf = 0;
+	b.nedges = 0;
+	b.hashSize = (int)ceil(sqrt(n)) + 1;
+
+	b.tri = malloc((3 * (size_t)(n > 3 ? 2 * n - 5 : 1)) * sizeof(int));
+	assert(b.tri != NULL);
+
+	b.half = malloc((3 * (size_t)(n > 3 ? 2 * n - 5 : 1)) * sizeof(int));
+	assert(b.half != NULL);
+
+	b.hullPrev = malloc((n + 1) * sizeof(int));
+	assert(b.hullPrev != NULL);
+
+	b.hullNext = malloc((n + 1) * sizeof(int));
+	assert(b.hullNext != NULL);
+
+	b.hullTri = malloc((n + 1) * sizeof(int));
+	assert(b.hullTri != NULL);
+
+	b.hullHash = malloc(b.hashSize * sizeof(int));
+	assert(b.hullHash != NULL);
+
+	b.ids = malloc((n + 1) * sizeof(int));
+	assert(b.ids != NULL);
+
+	b.key = malloc((n + 1) * sizeof(double));
+	assert(b.key != NULL);
+
+	b.ea = malloc((3 * (size_t)n + 1) * sizeof(int));
+	assert(b.ea != NULL);
+
+	b.eb = malloc((3 * (size_t)n + 1) * sizeof(int));
+	assert(b.eb != NULL);
+
+	if(n > 0){
+
+		minx = maxx = x[0];
+		miny = maxy = y[0];
+
+		for(i = 0; i < n; i++){
+			b.ids[i] = i;
+			minx = (x[i] < minx) ? x[i] : minx;
+			maxx = (x[i] > maxx) ? x[i] : maxx;
+			miny = (y[i] < miny) ? y[i] : miny;
+			maxy = (y[i] > maxy) ? y[i] : maxy;
+		}/* for */
+
+		/* seed: the point closest to the center, the one closest to it and the one giving the smallest circumcircle */
+		for(i = 0, best = INFINITY; i < n; i++){
+			double dx = x[i] - (minx + maxx) / 2, dy = y[i] - (miny + maxy) / 2;
+			if(dx * dx + dy * dy < best){
+				i0 = i;
+				best = dx * dx + dy * dy;
+			}/* if */
+		}/* for */
+
+		for(i = 0, best = INFINITY; i < n; i++){
+			double dx = x[i] - x[i0], dy = y[i] - y[i0];
+			if(dx * dx + dy * dy < best && dx * dx + dy * dy > 0){
+				i1 = i;
+				best = dx * dx + dy * dy;
+			}/* if */
+		}/* for */
+
+		for(i = 0, best = INFINITY; i1 != -1 && i < n; i++){
+			if(i != i0 && i != i1){
+				double r = dtCircumradius2(x[i0], y[i0], x[i1], y[i1], x[i], y[i]);
+				if(r < best){
+					i2 = i;
+					best = r;
+				}/* if */
+			}/* if */
+		}/* for */
+
+		if(i2 == -1)
+			dtChain(i0, i1, &b);
+		else{
+
+			if(dtOrient(x[i0], y[i0], x[i1], y[i1], x[i2], y[i2]) < 0)
+				swapInt(&i1, &i2);
+
+			dtSweep(i0, i1, i2, &b);
+
+		}/* if */
+
+	}/* if */
+
+	dtAdjacency(&b, g);
+
+	(*g).ntri = b.nhalf / 3;
+	(*g).tri = b.tri;
+
+	free(b.eb);
+	free(b.ea);
+	free(b.key);
+	free(b.ids);
+	free(b.hullHash);
+	free(b.hullTri);
+	free(b.hullNext);
+	free(b.hullPrev);
+	free(b.half);
+
+}/* buildDelaunay */
+
+/*
+* IOP g graph to free
+*/
+void freeDelaunay(DelaunayGraph* g){
+
+	free((*g).adj);
+	free((*g).first);
+	free((*g).tri);
+
+}/* freeDelaunay */
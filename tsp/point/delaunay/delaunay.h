@@ -0,0 +1,23 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : delaunay.h
+*/
+
+#pragma once
+
+#define DELAUNAY_EDGE_STACK 512 /* pending flips, only extremely degenerate inputs can exceed it */
+
+typedef struct {
+	int n;			/* n      := number of points */
+	int ntri;		/* ntri   := number of triangles */
+	int nedges;		/* nedges := number of edges */
+	int* tri;		/* tri    := tri[3t], tri[3t + 1], tri[3t + 2] vertices of the triangle t, counterclockwise */
+	int* first;		/* first  := adj[first[i] .. first[i + 1]) Delaunay neighbours of the point i */
+	int* adj;		/* adj    := neighbours of each point sorted by increasing distance, 2 * nedges elements */
+} DelaunayGraph;
+
+void buildDelaunay(int, const double*, const double*, DelaunayGraph*);
+
+void freeDelaunay(DelaunayGraph*);
@@ -0,0 +1,230 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : hilbert.c
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "hilbert.h"
+#include "../../utility/utility.h"
+
+/*
+* IP order the grid is 2^order x 2^order
+* IP x column of the cell, < 2^order
+* IP y row of the cell, < 2^order
+* OR position of the cell along the Hilbert curve that covers the grid
+* Reference:
+*	- https://en.wikipedia.org/wiki/Hilbert_curve
+*/
+uint64_t hilbertKey(int order, uint32_t x, uint32_t y){
+
+	uint32_t s, rx, ry, side = (uint32_t)1 << order;
+	uint64_t d = 0;
+
+	for(s = side / 2; s > 0; s /= 2){
+
+		rx = (x & s) > 0;
+		ry = (y & s) > 0;
+
+		d += (uint64_t)s * s * ((3 * rx) ^ ry);
+
+		/* rotate the quadrant so that the curve inside it has the canonical orientation */
+		if(ry == 0){
+
+			uint32_t t;
+
+			if(rx == 1){
+				x = side - 1 - x;
+				y = side - 1 - y;
+			}/* if */
+
+			t = x;
+			x = y;
+			y = t;
+
+		}/* if */
+
+	}/* for */
+
+	return d;
+
+}/* hilbertKey */
+
+/*
+* IP a HilbertItem
+* IP b HilbertItem
+* OR qsort comparator, by key then by index
+*/
+int compareHilbertItems(const void* a, const void* b){
+
+	const HilbertItem *p = a, *q = b;
+
+	if((*p).key != (*q).key)
+		return ((*p).key < (*q).key) ? -1 : 1;
+
+	return (*p).id - (*q).id;
+
+}/* compareHilbertItems */
+
+/*
+* IOP arg HILBERT_CHUNK whose keys are computed and sorted
+* OR NULL
+* NB: pthread entry point
+*/
+void* hilbertOrderChunk(void* arg){
+
+	HILBERT_CHUNK* chunk = arg;
+	int i;
+
+	for(i = (*chunk).first; i < (*chunk).last; i++){
+		uint32_t cx = (uint32_t)(((*chunk).x[i] - (*chunk).minx) * (*chunk).scale);
+		uint32_t cy = (uint32_t)(((*chunk).y[i] - (*chunk).miny) * (*chunk).scale);
+		(*chunk).items[i].key = hilbertKey(HILBERT_ORDER, cx, cy);
+		(*chunk).items[i].id = i;
+	}/* for */
+
+	qsort((*chunk).items + (*chunk).first, (*chunk).last - (*chunk).first, sizeof(HilbertItem), compareHilbertItems);
+
+	return NULL;
+
+}/* hilbertOrderChunk */
+
+/*
+* IP a sorted items
+* IP na number of $a
+* IP b sorted items
+* IP nb number of $b
+* OP out $a and $b merged, array of $na + $nb elements assumed to be already allocated
+*/
+void mergeHilbertItems(const HilbertItem* a, int na, const HilbertItem* b, int nb, HilbertItem* out){
+
+	int i = 0, j = 0, k = 0;
+
+	while(i < na && j < nb)
+		out[k++] = (compareHilbertItems(&(b[j]), &(a[i])) < 0) ? b[j++] : a[i++];
+
+	while(i < na)
+		out[k++] = a[i++];
+
+	while(j < nb)
+		out[k++] = b[j++];
+
+}/* mergeHilbertItems */
+
+/*
+* IP n number of points
+* IP x x coordinates of the points
+* IP y y coordinates of the points
+* IP nt number of threads
+* OP order points in the order they are visited by the Hilbert curve over their bounding box, array of $n elements
+*	assumed to be already allocated
+* NB: the box is made square so that both the axes have the same resolution, points in the same cell keep their order.
+*	Each chunk of at least HILBERT_MIN_CHUNK points gets its keys computed and is sorted through runChunks, then the
+*	chunks are merged two by two. The order is total, so it does not depend on the number of threads.
+*/
+void hilbertOrderThreads(int n, const double* x, const double* y, int nt, int* order){
+
+	int i, t, p, parts, *bounds;
+	double minx, miny, side, scale;
+	HilbertItem *items, *merged, *swap;
+	HILBERT_CHUNK* chunks;
+
+	if(n <= 0)
+		return;
+
+	minx = x[0];
+	miny = y[0];
+	side = 0;
+
+	for(i = 1; i < n; i++){
+		minx = (x[i] < minx) ? x[i] : minx;
+		miny = (y[i] < miny) ? y[i] : miny;
+	}/* for */
+
+	for(i = 0; i < n; i++){
+		side = (x[i] - minx > side) ? x[i] - minx : side;
+		side = (y[i] - miny > side) ? y[i] - miny : side;
+	}/* for */
+
+	scale = (side > 0) ? (((uint32_t)1 << HILBERT_ORDER) - 1) / side : 0;
+
+	if(nt > n / HILBERT_MIN_CHUNK)
+		nt = n / HILBERT_MIN_CHUNK;
+
+	if(nt < 1)
+		nt = 1;
+
+	items = malloc(n * sizeof(HilbertItem));
+	assert(items != NULL);
+
+	chunks = malloc(nt * sizeof(HILBERT_CHUNK));
+	assert(chunks != NULL);
+
+	bounds = malloc((nt + 1) * sizeof(int));
+	assert(bounds != NULL);
+
+	for(t = 0; t < nt; t++){
+		chunks[t].x = x;
+		chunks[t].y = y;
+		chunks[t].minx = minx;
+		chunks[t].miny = miny;
+		chunks[t].scale = scale;
+		chunks[t].items = items;
+		chunks[t].first = bounds[t] = (int)((long)n * t / nt);
+		chunks[t].last = (int)((long)n * (t + 1) / nt);
+	}/* for */
+
+	bounds[nt] = n;
+
+	runChunks(chunks, sizeof(HILBERT_CHUNK), nt, hilbertOrderChunk);
+
+	merged = (nt > 1) ? malloc(n * sizeof(HilbertItem)) : NULL;
+	assert(nt == 1 || merged != NULL);
+
+	/* the sorted parts items[bounds[p]..bounds[p + 1]) are merged two by two until one is left */
+	for(parts = nt; parts > 1; parts = (parts + 1) / 2){
+
+		for(p = 0; p + 1 < parts; p += 2)
+			mergeHilbertItems(items + bounds[p], bounds[p + 1] - bounds[p], items + bounds[p + 1], bounds[p + 2] - bounds[p + 1], merged + bounds[p]);
+
+		if(parts % 2)
+			for(i = bounds[parts - 1]; i < n; i++)
+				merged[i] = items[i];
+
+		for(p = 0; 2 * p < parts; p++)
+			bounds[p] = bounds[2 * p];
+
+		bounds[(parts + 1) / 2] = n;
+
+		swap = items;
+		items = merged;
+		merged = swap;
+
+	}/* for */
+
+	for(i = 0; i < n; i++)
+		order[i] = items[i].id;
+
+	free(merged);
+	free(bounds);
+	free(chunks);
+	free(items);
+
+}/* hilbertOrderThreads */
+
+/*
+* IP n number of points
+* IP x x coordinates of the points
+* IP y y coordinates of the points
+* OP order points in the order they are visited by the Hilbert curve over their bounding box, on all the available
+*	cores, see hilbertOrderThreads
+*/
+void hilbertOrder(int n, const double* x, const double* y, int* order){
+
+	hilbertOrderThreads(n, x, y, get_hardware_concurrency(), order);
+
+}/* hilbertOrder */
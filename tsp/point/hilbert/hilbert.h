@@ -0,0 +1,32 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : hilbert.h
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#define HILBERT_ORDER 16 /* the bounding box is split in a 2^16 x 2^16 grid */
+#define HILBERT_MIN_CHUNK 4096 /* fewest points sorted by a thread of hilbertOrderThreads */
+
+typedef struct {
+	uint64_t key;	/* key := position along the Hilbert curve */
+	int id;			/* id  := point index */
+} HilbertItem;
+
+typedef struct {
+	const double *x, *y;	/* x, y   := coordinates of the points */
+	double minx, miny;		/* minx, miny := corner of the square the curve covers */
+	double scale;			/* scale  := cells per unit of length */
+	HilbertItem* items;		/* items  := keys of the points, the chunk sorts $items[first..last) */
+	int first, last;		/* first, last := the chunk covers the points [first, last) */
+} HILBERT_CHUNK;
+
+uint64_t hilbertKey(int, uint32_t, uint32_t);
+
+void hilbertOrderThreads(int, const double*, const double*, int, int*);
+
+void hilbertOrder(int, const double*, const double*, int*);
@@ -0,0 +1,551 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : kdtree.c
+*/
+
+#include <stdlib.h>
+#include <assert.h>
+
+#include "kdtree.h"
+#include "../../utility/utility.h"
+
+/*
+* State of a running query, shared by the recursive visits.
+*/
+typedef struct {
+	double x, y;	/* query point */
+	int exclude;	/* point to skip, -1 if none */
+	int quadrant;	/* quadrant around the query point the points must lie in, -1 if any (see kdInQuadrant) */
+	int k;			/* maximum number of points to return (k-nearest) */
+	double r2;		/* squared radius (fixed-radius) */
+	int count;		/* points found so far */
+	int* out;		/* points found, a max-heap on the distance while a k-nearest query is running */
+} KDQuery;
+
+/*
+* IP tree k-d tree
+* IP dim 0 for x, 1 for y
+* IP i point index
+* OR coordinate $dim of the point $i
+*/
+double kdCoord(const KDTree* tree, int dim, int i){
+	return dim ? (*tree).y[i] : (*tree).x[i];
+}/* kdCoord */
+
+/*
+* IP tree k-d tree
+* IP q query
+* IP i point index
+* OR squared distance between the query point and the point $i
+*/
+double kdDist2(const KDTree* tree, const KDQuery* q, int i){
+
+	double dx = (*tree).x[i] - (*q).x, dy = (*tree).y[i] - (*q).y;
+
+	return dx * dx + dy * dy;
+
+}/* kdDist2 */
+
+/*
+* IP node k-d tree node
+* IP q query
+* OR squared distance between the query point and the bounding box of $node, 0 if it is inside
+*/
+double kdBoxDist2(const KDNode* node, const KDQuery* q){
+
+	double dx = 0, dy = 0;
+
+	if((*q).x < (*node).xmin)
+		dx = (*node).xmin - (*q).x;
+	else if((*q).x > (*node).xmax)
+		dx = (*q).x - (*node).xmax;
+
+	if((*q).y < (*node).ymin)
+		dy = (*node).ymin - (*q).y;
+	else if((*q).y > (*node).ymax)
+		dy = (*q).y - (*node).ymax;
+
+	return dx * dx + dy * dy;
+
+}/* kdBoxDist2 */
+
+/*
+* IP q query
+* IP x x coordinate of the point
+* IP y y coordinate of the point
+* OR true if the point lies in the quadrant of the query, the four quadrants are half-open so that every point but
+*	the query one lies in exactly one of them: 0 x > qx, y >= qy; 1 x <= qx, y > qy; 2 x < qx, y <= qy; 3 x >= qx, y < qy
+*/
+bool kdInQuadrant(const KDQuery* q, double x, double y){
+
+	switch((*q).quadrant){
+		case 0: return x > (*q).x && y >= (*q).y;
+		case 1: return x <= (*q).x && y > (*q).y;
+		case 2: return x < (*q).x && y <= (*q).y;
+		case 3: return x >= (*q).x && y < (*q).y;
+		default: return true;
+	}/* switch */
+
+}/* kdInQuadrant */
+
+/*
+* IP node k-d tree node
+* IP q query
+* OR false if no point of the bounding box of $node lies in the quadrant of the query
+*/
+bool kdBoxInQuadrant(const KDNode* node, const KDQuery* q){
+
+	switch((*q).quadrant){
+		case 0: return (*node).xmax > (*q).x && (*node).ymax >= (*q).y;
+		case 1: return (*node).xmin <= (*q).x && (*node).ymax > (*q).y;
+		case 2: return (*node).xmin < (*q).x && (*node).ymin <= (*q).y;
+		case 3: return (*node).xmax >= (*q).x && (*node).ymin < (*q).y;
+		default: return true;
+	}/* switch */
+
+}/* kdBoxInQuadrant */
+
+/*
+* IP n number of points
+* OP tree k-d tree to allocate, it can be built several times with buildKDTree
+* NB: an internal node holds more than KD_BUCKET_SIZE points and is split in halves, so each leaf holds at least
+*	(KD_BUCKET_SIZE + 1) / 2 points and there are less than 2n / ((KD_BUCKET_SIZE + 1) / 2) + 1 nodes
+*/
+void allocKDTree(int n, KDTree* tree){
+
+	(*tree).n = n;
+	(*tree).nnodes = 0;
+
+	(*tree).perm = malloc(n * sizeof(int));
+	assert((*tree).perm != NULL);
+
+	(*tree).leaf = malloc(n * sizeof(int));
+	assert((*tree).leaf != NULL);
+
+	(*tree).nodes = malloc((2 * (n / ((KD_BUCKET_SIZE + 1) / 2)) + 1) * sizeof(KDNode));
+	assert((*tree).nodes != NULL);
+
+}/* allocKDTree */
+
+/*
+* IOP tree k-d tree to free
+*/
+void freeKDTree(KDTree* tree){
+
+	free((*tree).nodes);
+	free((*tree).leaf);
+	free((*tree).perm);
+
+}/* freeKDTree */
+
+/*
+* IP dim coordinate to select on
+* IP lo first position of the range
+* IP hi position after the last of the range
+* IP k position to select
+* IOP tree k-d tree whose perm[lo..hi) is reordered so that perm[k] is the point with the k-th coordinate $dim,
+*	the ones before it have coordinate <= and the ones after >=
+* NB: Hoare quickselect, expected O(hi - lo), it behaves well with many equal coordinates
+*/
+void kdSelect(int dim, int lo, int hi, int k, KDTree* tree){
+
+	while(hi - lo > 1){
+
+		int i = lo, j = hi - 1;
+		double pivot = kdCoord(tree, dim, (*tree).perm[lo + (hi - lo) / 2]);
+
+		while(i <= j){
+
+			while(kdCoord(tree, dim, (*tree).perm[i]) < pivot)
+				i++;
+
+			while(kdCoord(tree, dim, (*tree).perm[j]) > pivot)
+				j--;
+
+			if(i <= j)
+				swapInt(&((*tree).perm[i++]), &((*tree).perm[j--]));
+
+		}/* while */
+
+		if(k <= j)
+			hi = j + 1;
+		else if(k >= i)
+			lo = i;
+		else
+			return; /* perm[j + 1..i) are all equal to the pivot */
+
+	}/* while */
+
+}/* kdSelect */
+
+/*
+* IP lo first position of the range
+* IP hi position after the last of the range
+* IP parent parent node, -1 for the root
+* IOP tree k-d tree on which the node covering perm[lo..hi) is built
+* OR index of the node
+*/
+int buildKDNode(int lo, int hi, int parent, KDTree* tree){
+
+	int k, m, v = (*tree).nnodes++;
+	KDNode* node = &((*tree).nodes[v]);
+
+	(*node).lo = lo;
+	(*node).hi = hi;
+	(*node).parent = parent;
+	(*node).left = (*node).right = -1;
+
+	(*node).xmin = (*node).xmax = (*tree).x[(*tree).perm[lo]];
+	(*node).ymin = (*node).ymax = (*tree).y[(*tree).perm[lo]];
+
+	for(k = lo + 1; k < hi; k++){
+
+		int i = (*tree).perm[k];
+
+		if((*tree).x[i] < (*node).xmin) (*node).xmin = (*tree).x[i];
+		if((*tree).x[i] > (*node).xmax) (*node).xmax = (*tree).x[i];
+		if((*tree).y[i] < (*node).ymin) (*node).ymin = (*tree).y[i];
+		if((*tree).y[i] > (*node).ymax) (*node).ymax = (*tree).y[i];
+
+	}/* for */
+
+	if(hi - lo <= KD_BUCKET_SIZE){
+
+		(*node).cutdim = -1;
+
+		for(k = lo; k < hi; k++)
+			(*tree).leaf[(*tree).perm[k]] = v;
+
+		return v;
+
+	}/* if */
+
+	/* cut the widest side at the median */
+	(*node).cutdim = ((*node).xmax - (*node).xmin >= (*node).ymax - (*node).ymin) ? 0 : 1;
+
+	m = lo + (hi - lo) / 2;
+
+	kdSelect((*node).cutdim, lo, hi, m, tree);
+
+	(*node).cutval = kdCoord(tree, (*node).cutdim, (*tree).perm[m]);
+
+	(*node).left = buildKDNode(lo, m, v, tree);
+	(*node).right = buildKDNode(m, hi, v, tree);
+
+	return v;
+
+}/* buildKDNode */
+
+/*
+* IP x x coordinates of the points
+* IP y y coordinates of the points
+* IOP tree k-d tree allocated with allocKDTree, built over the points in O(n log n)
+* NB: the coordinates are not copied, they must outlive the tree
+*/
+void buildKDTree(const double* x, const double* y, KDTree* tree){
+
+	int i;
+
+	(*tree).x = x;
+	(*tree).y = y;
+	(*tree).nnodes = 0;
+
+	for(i = 0; i < (*tree).n; i++)
+		(*tree).perm[i] = i;
+
+	if((*tree).n > 0)
+		buildKDNode(0, (*tree).n, -1, tree);
+
+}/* buildKDTree */
+
+/*
+* IP tree k-d tree
+* OP live deletion state to allocate, initially no point is deleted
+*/
+void allocKDLive(const KDTree* tree, KDLive* live){
+
+	(*live).live = malloc((2 * ((*tree).n / ((KD_BUCKET_SIZE + 1) / 2)) + 1) * sizeof(int));
+	assert((*live).live != NULL);
+
+	(*live).deleted = malloc((*tree).n * sizeof(bool));
+	assert((*live).deleted != NULL);
+
+	resetKDLive(tree, live);
+
+}/* allocKDLive */
+
+/*
+* IP tree k-d tree
+* IOP live deletion state, every point is restored
+*/
+void resetKDLive(const KDTree* tree, KDLive* live){
+
+	int i;
+
+	for(i = 0; i < (*tree).nnodes; i++)
+		(*live).live[i] = (*tree).nodes[i].hi - (*tree).nodes[i].lo;
+
+	for(i = 0; i < (*tree).n; i++)
+		(*live).deleted[i] = false;
+
+}/* resetKDLive */
+
+/*
+* IOP live deletion state to free
+*/
+void freeKDLive(KDLive* live){
+
+	free((*live).deleted);
+	free((*live).live);
+
+}/* freeKDLive */
+
+/*
+* IP tree k-d tree
+* IP i point to delete
+* IOP live deletion state
+* NB: O(log n), the emptied subtrees are skipped by the queries
+*/
+void kdDelete(const KDTree* tree, int i, KDLive* live){
+
+	int v;
+
+	if((*live).deleted[i])
+		return;
+
+	(*live).deleted[i] = true;
+
+	for(v = (*tree).leaf[i]; v != -1; v = (*tree).nodes[v].parent)
+		(*live).live[v]--;
+
+}/* kdDelete */
+
+/*
+* IP tree k-d tree
+* IP q query
+* IP a point index
+* IP b point index
+* OR true if $a is farther than $b from the query point, ties broken by the index so that results are deterministic
+*/
+bool kdWorse(const KDTree* tree, const KDQuery* q, int a, int b){
+
+	double da = kdDist2(tree, q, a), db = kdDist2(tree, q, b);
+
+	return da > db || (da == db && a > b);
+
+}/* kdWorse */
+
+/*
+* IP tree k-d tree
+* IP n heap size
+* IP h position to sift down
+* IOP q query whose $q->out[0..n) is a max-heap
+*/
+void kdSiftDown(const KDTree* tree, int n, int h, KDQuery* q){
+
+	while(2 * h + 1 < n){
+
+		int c = 2 * h + 1;
+
+		if(c + 1 < n && kdWorse(tree, q, (*q).out[c + 1], (*q).out[c]))
+			c++;
+
+		if(!kdWorse(tree, q, (*q).out[c], (*q).out[h]))
+			return;
+
+		swapInt(&((*q).out[c]), &((*q).out[h]));
+		h = c;
+
+	}/* while */
+
+}/* kdSiftDown */
+
+/*
+* IP tree k-d tree
+* IP i candidate point
+* IOP q query whose heap is updated with $i
+*/
+void kdOffer(const KDTree* tree, int i, KDQuery* q){
+
+	int h;
+
+	if((*q).count < (*q).k){
+
+		(*q).out[h = (*q).count++] = i;
+
+		while(h > 0 && kdWorse(tree, q, (*q).out[h], (*q).out[(h - 1) / 2])){
+			swapInt(&((*q).out[h]), &((*q).out[(h - 1) / 2]));
+			h = (h - 1) / 2;
+		}/* while */
+
+	}else if(kdWorse(tree, q, (*q).out[0], i)){
+
+		(*q).out[0] = i;
+		kdSiftDown(tree, (*q).count, 0, q);
+
+	}/* if */
+
+}/* kdOffer */
+
+/*
+* IP tree k-d tree
+* IP live deletion state, NULL if no point is deleted
+* IP v node to visit
+* IOP q k-nearest query
+*/
+void kdKNearestNode(const KDTree* tree, const KDLive* live, int v, KDQuery* q){
+
+	int k;
+	const KDNode* node = &((*tree).nodes[v]);
+
+	if((live != NULL && (*live).live[v] == 0) || !kdBoxInQuadrant(node, q))
+		return;
+
+	if((*q).count == (*q).k && kdBoxDist2(node, q) > kdDist2(tree, q, (*q).out[0]))
+		return;
+
+	if((*node).cutdim < 0){
+
+		for(k = (*node).lo; k < (*node).hi; k++){
+
+			int i = (*tree).perm[k];
+
+			if(i != (*q).exclude && (live == NULL || !(*live).deleted[i]) && kdInQuadrant(q, (*tree).x[i], (*tree).y[i]))
+				kdOffer(tree, i, q);
+
+		}/* for */
+
+		return;
+
+	}/* if */
+
+	/* nearer child first, so that the farther one is likely pruned */
+	if(((*node).cutdim ? (*q).y : (*q).x) < (*node).cutval){
+		kdKNearestNode(tree, live, (*node).left, q);
+		kdKNearestNode(tree, live, (*node).right, q);
+	}else{
+		kdKNearestNode(tree, live, (*node).right, q);
+		kdKNearestNode(tree, live, (*node).left, q);
+	}/* if */
+
+}/* kdKNearestNode */
+
+/*
+* IP tree k-d tree
+* IP live deletion state, NULL if no point is deleted
+* IP x x coordinate of the query point
+* IP y y coordinate of the query point
+* IP exclude point to skip (e.g. the query point itself), -1 if none
+* IP quadrant quadrant around the query point the points must lie in (0..3, see kdInQuadrant), -1 if any
+* IP k number of points to find
+* OP out the (at most) $k nearest points sorted by increasing distance, array of $k elements assumed to be already allocated
+* OR number of points found, less than $k only if there are not enough points
+*/
+int kdKNearestQuadrant(const KDTree* tree, const KDLive* live, double x, double y, int exclude, int quadrant, int k, int* out){
+
+	int n;
+	KDQuery q = { .x = x, .y = y, .exclude = exclude, .quadrant = quadrant, .k = k, .count = 0, .out = out };
+
+	if(k <= 0 || (*tree).nnodes == 0)
+		return 0;
+
+	kdKNearestNode(tree, live, 0, &q);
+
+	/* heap sort, the max-heap becomes increasing */
+	for(n = q.count - 1; n > 0; n--){
+		swapInt(&(out[0]), &(out[n]));
+		kdSiftDown(tree, n, 0, &q);
+	}/* for */
+
+	return q.count;
+
+}/* kdKNearestQuadrant */
+
+/*
+* IP tree k-d tree
+* IP live deletion state, NULL if no point is deleted
+* IP x x coordinate of the query point
+* IP y y coordinate of the query point
+* IP exclude point to skip (e.g. the query point itself), -1 if none
+* IP k number of points to find
+* OP out the (at most) $k nearest points sorted by increasing distance, array of $k elements assumed to be already allocated
+* OR number of points found, less than $k only if there are not enough points
+* NB: O(log n + k log k) expected on spread points
+*/
+int kdKNearest(const KDTree* tree, const KDLive* live, double x, double y, int exclude, int k, int* out){
+
+	return kdKNearestQuadrant(tree, live, x, y, exclude, -1, k, out);
+
+}/* kdKNearest */
+
+/*
+* IP tree k-d tree
+* IP live deletion state, NULL if no point is deleted
+* IP x x coordinate of the query point
+* IP y y coordinate of the query point
+* IP exclude point to skip (e.g. the query point itself), -1 if none
+* OR nearest point, -1 if there is none
+*/
+int kdNearest(const KDTree* tree, const KDLive* live, double x, double y, int exclude){
+
+	int nearest;
+
+	if(!kdKNearest(tree, live, x, y, exclude, 1, &nearest))
+		return -1;
+
+	return nearest;
+
+}/* kdNearest */
+
+/*
+* IP tree k-d tree
+* IP live deletion state, NULL if no point is deleted
+* IP v node to visit
+* IOP q fixed-radius query
+*/
+void kdRadiusNode(const KDTree* tree, const KDLive* live, int v, KDQuery* q){
+
+	int k;
+	const KDNode* node = &((*tree).nodes[v]);
+
+	if((live != NULL && (*live).live[v] == 0) || kdBoxDist2(node, q) > (*q).r2)
+		return;
+
+	if((*node).cutdim >= 0){
+		kdRadiusNode(tree, live, (*node).left, q);
+		kdRadiusNode(tree, live, (*node).right, q);
+		return;
+	}/* if */
+
+	for(k = (*node).lo; k < (*node).hi; k++){
+
+		int i = (*tree).perm[k];
+
+		if((live == NULL || !(*live).deleted[i]) && kdDist2(tree, q, i) <= (*q).r2)
+			(*q).out[(*q).count++] = i;
+
+	}/* for */
+
+}/* kdRadiusNode */
+
+/*
+* IP tree k-d tree
+* IP live deletion state, NULL if no point is deleted
+* IP x x coordinate of the query point
+* IP y y coordinate of the query point
+* IP r radius
+* OP out points within distance $r, in no particular order, array of $tree->n elements assumed to be already allocated
+* OR number of points found
+*/
+int kdRadius(const KDTree* tree, const KDLive* live, double x, double y, double r, int* out){
+
+	KDQuery q = { .x = x, .y = y, .exclude = -1, .quadrant = -1, .r2 = r * r, .count = 0, .out = out };
+
+	if((*tree).nnodes > 0)
+		kdRadiusNode(tree, live, 0, &q);
+
+	return q.count;
+
+}/* kdRadius */
@@ -0,0 +1,56 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : kdtree.h
+*/
+
+#pragma once
+
+#include <stdbool.h>
+
+#define KD_BUCKET_SIZE 8 /* maximum number of points of a leaf */
+
+typedef struct {
+	double xmin, xmax, ymin, ymax;	/* bounding box of the points of the node */
+	double cutval;					/* cutval := the left child has coordinate $cutdim <= $cutval, the right one >= */
+	int cutdim;						/* cutdim := 0 for x, 1 for y, -1 for a leaf */
+	int lo, hi;						/* lo, hi := the node covers perm[lo..hi) */
+	int left, right, parent;		/* children and parent node indexes, -1 if missing */
+} KDNode;
+
+typedef struct {
+	int n;				/* n      := number of points */
+	int nnodes;			/* nnodes := number of nodes in use */
+	const double *x, *y;	/* x, y := coordinates of the points (not owned) */
+	int* perm;			/* perm   := point indexes ordered so that each node covers a contiguous range */
+	int* leaf;			/* leaf   := leaf[i] is the leaf node containing the point i */
+	KDNode* nodes;		/* nodes  := node 0 is the root */
+} KDTree;
+
+typedef struct {
+	int* live;			/* live    := live[v] number of points under the node v not deleted yet */
+	bool* deleted;		/* deleted := deleted[i] true if the point i has been deleted */
+} KDLive;
+
+void allocKDTree(int, KDTree*);
+
+void buildKDTree(const double*, const double*, KDTree*);
+
+void freeKDTree(KDTree*);
+
+void allocKDLive(const KDTree*, KDLive*);
+
+void resetKDLive(const KDTree*, KDLive*);
+
+void freeKDLive(KDLive*);
+
+void kdDelete(const KDTree*, int, KDLive*);
+
+int kdNearest(const KDTree*, const KDLive*, double, double, int);
+
+int kdKNearest(const KDTree*, const KDLive*, double, double, int, int, int*);
+
+int kdKNearestQuadrant(const KDTree*, const KDLive*, double, double, int, int, int, int*);
+
+int kdRadius(const KDTree*, const KDLive*, double, double, double, int*);
@@ -8,16 +8,25 @@
 #include <stdlib.h>
 #include <math.h>
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "point.h"
 #include "../utility/utility.h"
 
 /*
-* OP p random point in the square [0, MAX_RANDOM_VALUE]^2
+* IOP rng generator
+* OP p random point with integer coordinates in the square [0, MAX_RANDOM_VALUE]^2
 */
-void randomPoint(Point2D* p){
+void randomPoint(RNG* rng, Point2D* p){
 
-    p->x = rand0N(MAX_RANDOM_VALUE + 1);
-    p->y = rand0N(MAX_RANDOM_VALUE + 1);
+    p->x = rngBelow(rng, MAX_RANDOM_VALUE + 1);
+    p->y = rngBelow(rng, MAX_RANDOM_VALUE + 1);
 
 }/* randomPoint */
 
@@ -48,11 +57,278 @@ double originDistance(const Point2D* p){
 */
 double distance(const Point2D* p1, const Point2D* p2){
     
-    Point2D pdiff;
-
-    pdiff.x = (*p1).x - (*p2).x;
-    pdiff.y = (*p1).y - (*p2).y;
+    double dx = (*p1).x - (*p2).x, dy = (*p1).y - (*p2).y;
 
-    return originDistance(&pdiff);
+    return sqrt(dx * dx + dy * dy);
 
 }/* distance */
+
+/*
+* IP px x coordinate of the reference point
+* IP py y coordinate of the reference point
+* IP xs x coordinates of the points
+* IP ys y coordinates of the points
+* IP n number of points
+* OP out out[j] = distance between the reference point and the point j
+* NB: same operations of distance(), so the results are bit-identical to it
+*/
+void distanceRowScalar(double px, double py, const double* xs, const double* ys, int n, double* out){
+
+	int j;
+
+	for(j = 0; j < n; j++){
+		double dx = xs[j] - px, dy = ys[j] - py;
+		out[j] = sqrt(dx * dx + dy * dy);
+	}/* for */
+
+}/* distanceRowScalar */
+
+/*
+* IP px x coordinate of the reference point
+* IP py y coordinate of the reference point
+* IP xs x coordinates of the points
+* IP ys y coordinates of the points
+* IP n number of points
+* OP out out[j] = distance between the reference point and the point j
+* NB: vectorised version of distanceRowScalar (AVX, SSE2 or NEON, whatever the compiler targets), the tail is
+*		completed by the scalar version. IEEE mul, add and sqrt are correctly rounded in both paths and there
+*		is no fused multiply-add, so the results are bit-identical.
+*/
+void distanceRow(double px, double py, const double* xs, const double* ys, int n, double* out){
+
+	int j = 0;
+
+#if defined(__AVX__)
+	__m256d vpx = _mm256_set1_pd(px), vpy = _mm256_set1_pd(py);
+
+	for(; j + 4 <= n; j += 4){
+		__m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + j), vpx);
+		__m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + j), vpy);
+		_mm256_storeu_pd(out + j, _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy))));
+	}/* for */
+#elif defined(__SSE2__)
+	__m128d vpx = _mm_set1_pd(px), vpy = _mm_set1_pd(py);
+
+	for(; j + 2 <= n; j += 2){
+		__m128d dx = _mm_sub_pd(_mm_loadu_pd(xs + j), vpx);
+		__m128d dy = _mm_sub_pd(_mm_loadu_pd(ys + j), vpy);
+		_mm_storeu_pd(out + j, _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy))));
+	}/* for */
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	float64x2_t vpx = vdupq_n_f64(px), vpy = vdupq_n_f64(py);
+
+	for(; j + 2 <= n; j += 2){
+		float64x2_t dx = vsubq_f64(vld1q_f64(xs + j), vpx);
+		float64x2_t dy = vsubq_f64(vld1q_f64(ys + j), vpy);
+		vst1q_f64(out + j, vsqrtq_f64(vaddq_f64(vmulq_f64(dx, dx), vmulq_f64(dy, dy))));
+	}/* for */
+#endif
+
+	distanceRowScalar(px, py, xs + j, ys + j, n - j, out + j);
+
+}/* distanceRow */
+
+/*
+* IP px x coordinate of the reference point
+* IP py y coordinate of the reference point
+* IP xs x coordinates of the points
+* IP ys y coordinates of the points
+* IP n number of points, at least 1
+* OP d2 squared distance between the reference point and the nearest point
+* OR index of the nearest point, the first one on ties
+* NB: squared distances are compared, they have the order of the distances without the sqrt
+*/
+int nearestPointScalar(double px, double py, const double* xs, const double* ys, int n, double* d2){
+
+	int j, best = 0;
+	double min = INFINITY;
+
+	for(j = 0; j < n; j++){
+
+		double dx = xs[j] - px, dy = ys[j] - py, d = dx * dx + dy * dy;
+
+		if(d < min){
+			min = d;
+			best = j;
+		}/* if */
+
+	}/* for */
+
+	*d2 = min;
+
+	return best;
+
+}/* nearestPointScalar */
+
+/*
+* IP px x coordinate of the reference point
+* IP py y coordinate of the reference point
+* IP xs x coordinates of the points
+* IP ys y coordinates of the points
+* IP n number of points, at least 1
+* OP d2 squared distance between the reference point and the nearest point
+* OR index of the nearest point, the first one on ties
+* NB: vectorised version of nearestPointScalar (AVX, SSE2 or NEON, whatever the compiler targets). Each lane keeps
+*		the minimum of its points and its index, the lanes are reduced at the end preferring the smaller index on
+*		ties and the tail is completed by the scalar version, so the result is the one of nearestPointScalar.
+*/
+int nearestPoint(double px, double py, const double* xs, const double* ys, int n, double* d2){
+
+	int j = 0, l, best = 0, tail;
+	double min = INFINITY, tmin;
+	double lmin[4], lidx[4];
+
+#if defined(__AVX__)
+	__m256d vpx = _mm256_set1_pd(px), vpy = _mm256_set1_pd(py);
+	__m256d vmin = _mm256_set1_pd(INFINITY), vidx = _mm256_setzero_pd();
+	__m256d cur = _mm256_set_pd(3, 2, 1, 0), step = _mm256_set1_pd(4);
+
+	for(; j + 4 <= n; j += 4){
+		__m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + j), vpx);
+		__m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + j), vpy);
+		__m256d d = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+		__m256d lt = _mm256_cmp_pd(d, vmin, _CMP_LT_OQ);
+		vmin = _mm256_blendv_pd(vmin, d, lt);
+		vidx = _mm256_blendv_pd(vidx, cur, lt);
+		cur = _mm256_add_pd(cur, step);
+	}/* for */
+
+	_mm256_storeu_pd(lmin, vmin);
+	_mm256_storeu_pd(lidx, vidx);
+	l = 4;
+#elif defined(__SSE2__)
+	__m128d vpx = _mm_set1_pd(px), vpy = _mm_set1_pd(py);
+	__m128d vmin = _mm_set1_pd(INFINITY), vidx = _mm_setzero_pd();
+	__m128d cur = _mm_set_pd(1, 0), step = _mm_set1_pd(2);
+
+	for(; j + 2 <= n; j += 2){
+		__m128d dx = _mm_sub_pd(_mm_loadu_pd(xs + j), vpx);
+		__m128d dy = _mm_sub_pd(_mm_loadu_pd(ys + j), vpy);
+		__m128d d = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+		__m128d lt = _mm_cmplt_pd(d, vmin);
+		vmin = _mm_or_pd(_mm_and_pd(lt, d), _mm_andnot_pd(lt, vmin));
+		vidx = _mm_or_pd(_mm_and_pd(lt, cur), _mm_andnot_pd(lt, vidx));
+		cur = _mm_add_pd(cur, step);
+	}/* for */
+
+	_mm_storeu_pd(lmin, vmin);
+	_mm_storeu_pd(lidx, vidx);
+	l = 2;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	float64x2_t vpx = vdupq_n_f64(px), vpy = vdupq_n_f64(py);
+	float64x2_t vmin = vdupq_n_f64(INFINITY), vidx = vdupq_n_f64(0);
+	float64x2_t cur = {0, 1}, step = vdupq_n_f64(2);
+
+	for(; j + 2 <= n; j += 2){
+		float64x2_t dx = vsubq_f64(vld1q_f64(xs + j), vpx);
+		float64x2_t dy = vsubq_f64(vld1q_f64(ys + j), vpy);
+		float64x2_t d = vaddq_f64(vmulq_f64(dx, dx), vmulq_f64(dy, dy));
+		uint64x2_t lt = vcltq_f64(d, vmin);
+		vmin = vbslq_f64(lt, d, vmin);
+		vidx = vbslq_f64(lt, cur, vidx);
+		cur = vaddq_f64(cur, step);
+	}/* for */
+
+	vst1q_f64(lmin, vmin);
+	vst1q_f64(lidx, vidx);
+	l = 2;
+#else
+	l = 0;
+#endif
+
+	while(l-- > 0)
+		if(lmin[l] < min || (lmin[l] == min && (int)lidx[l] < best)){
+			min = lmin[l];
+			best = (int)lidx[l];
+		}/* if */
+
+	if(j < n){
+
+		tail = j + nearestPointScalar(px, py, xs + j, ys + j, n - j, &tmin);
+
+		if(tmin < min){
+			min = tmin;
+			best = tail;
+		}/* if */
+
+	}/* if */
+
+	*d2 = min;
+
+	return best;
+
+}/* nearestPoint */
+
+/*
+* IP px x coordinate of the reference point
+* IP py y coordinate of the reference point
+* IP xs x coordinates of the points
+* IP ys y coordinates of the points
+* IP n number of points
+* OP out out[j] = CEIL_2D distance between the reference point and the point j
+*/
+void distanceRowCeil2D(double px, double py, const double* xs, const double* ys, int n, double* out){
+
+	int j;
+
+	for(j = 0; j < n; j++)
+		out[j] = ceil2D(px, py, xs[j], ys[j]);
+
+}/* distanceRowCeil2D */
+
+/*
+* IP px x coordinate of the reference point
+* IP py y coordinate of the reference point
+* IP xs x coordinates of the points
+* IP ys y coordinates of the points
+* IP n number of points
+* OP out out[j] = ATT distance between the reference point and the point j
+*/
+void distanceRowAtt(double px, double py, const double* xs, const double* ys, int n, double* out){
+
+	int j;
+
+	for(j = 0; j < n; j++)
+		out[j] = att(px, py, xs[j], ys[j]);
+
+}/* distanceRowAtt */
+
+/*
+* IP px latitude of the reference point
+* IP py longitude of the reference point
+* IP xs latitudes of the points
+* IP ys longitudes of the points
+* IP n number of points
+* OP out out[j] = GEO distance between the reference point and the point j
+* NB: the distance of a point from itself is 1 with the TSPLIB formula, the diagonal is cleared by the caller
+*/
+void distanceRowGeo(double px, double py, const double* xs, const double* ys, int n, double* out){
+
+	int j;
+
+	for(j = 0; j < n; j++)
+		out[j] = geo(px, py, xs[j], ys[j]);
+
+}/* distanceRowGeo */
+
+/*
+* IP metric metric of the instance
+* OR kernel computing a row of the distance matrix with $metric, NULL with METRIC_EXPLICIT
+* NB: it is chosen once per matrix, each kernel has its metric inlined so there is no switch per entry
+*/
+distrowfunc metricDistanceRow(DIST_METRIC metric){
+
+	switch(metric){
+		case METRIC_EUC_2D:
+			return (distrowfunc)distanceRow;
+		case METRIC_CEIL_2D:
+			return (distrowfunc)distanceRowCeil2D;
+		case METRIC_ATT:
+			return (distrowfunc)distanceRowAtt;
+		case METRIC_GEO:
+			return (distrowfunc)distanceRowGeo;
+		default:
+			return NULL;
+	}/* switch */
+
+}/* metricDistanceRow */
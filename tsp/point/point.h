@@ -5,13 +5,111 @@
 * File     : point.h
 */
 
+#pragma once
+
+#include <math.h>
+
+#include "../utility/rng/rng.h"
+
 #define MAX_RANDOM_VALUE 1e4
+#define GEO_PI 3.141592 /* value of pi the TSPLIB GEO distance is defined with */
+#define GEO_EARTH_RADIUS 6378.388 /* km */
+
+typedef enum {
+	METRIC_EUC_2D,		/* Euclidean distance, rounded only as the precision of the distances requires */
+	METRIC_CEIL_2D,		/* Euclidean distance rounded up */
+	METRIC_ATT,			/* pseudo-Euclidean distance of the TSPLIB att instances */
+	METRIC_GEO,			/* geographical distance in km, coordinates are latitude and longitude as DDD.MM */
+	METRIC_EXPLICIT		/* distances given by the file, the coordinates are only for display (if any) */
+} DIST_METRIC;
+
+/*
+* IP px x coordinate of the reference point
+* IP py y coordinate of the reference point
+* IP xs x coordinates of the points
+* IP ys y coordinates of the points
+* IP n number of points
+* OP out distances between the reference point and the points
+*/
+typedef void (*distrowfunc)(double, double, const double*, const double*, int, double*);
+
+/*
+* IP px, py coordinates of the first point
+* IP qx, qy coordinates of the second point
+* OR Euclidean distance rounded up (TSPLIB CEIL_2D)
+*/
+static inline double ceil2D(double px, double py, double qx, double qy){
+
+	double dx = qx - px, dy = qy - py;
+
+	return ceil(sqrt(dx * dx + dy * dy));
+
+}/* ceil2D */
+
+/*
+* IP px, py coordinates of the first point
+* IP qx, qy coordinates of the second point
+* OR pseudo-Euclidean distance (TSPLIB ATT)
+*/
+static inline double att(double px, double py, double qx, double qy){
+
+	double dx = qx - px, dy = qy - py;
+	double r = sqrt((dx * dx + dy * dy) / 10.0);
+	int t = (int)(r + .5);
+
+	return (t < r) ? t + 1 : t;
+
+}/* att */
+
+/*
+* IP c coordinate as DDD.MM (degrees and minutes)
+* OR $c in radians
+*/
+static inline double geoRadians(double c){
+
+	int deg = (int)c;
+
+	return GEO_PI * (deg + 5.0 * (c - deg) / 3.0) / 180.0;
+
+}/* geoRadians */
+
+/*
+* IP px, py latitude and longitude of the first point
+* IP qx, qy latitude and longitude of the second point
+* OR geographical distance in km (TSPLIB GEO)
+* NB: the degrees are truncated, not rounded, as the TSPLIB optimal tour lengths are computed
+*/
+static inline double geo(double px, double py, double qx, double qy){
+
+	double plat = geoRadians(px), plon = geoRadians(py), qlat = geoRadians(qx), qlon = geoRadians(qy);
+	double q1 = cos(plon - qlon), q2 = cos(plat - qlat), q3 = cos(plat + qlat);
+
+	return (int)(GEO_EARTH_RADIUS * acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+
+}/* geo */
 
 /* Bidimensional point on the cartesian plane */
 typedef struct {
     double x, y;
 } Point2D;
 
-void randomPoint(Point2D*);
+void randomPoint(RNG*, Point2D*);
 
 double distance(const Point2D*, const Point2D*);
+
+void distanceRowScalar(double, double, const double*, const double*, int, double*);
+
+void distanceRow(double, double, const double*, const double*, int, double*);
+
+int nearestPointScalar(double, double, const double*, const double*, int, double*);
+
+int nearestPoint(double, double, const double*, const double*, int, double*);
+
+void distanceRowCeil2D(double, double, const double*, const double*, int, double*);
+
+void distanceRowAtt(double, double, const double*, const double*, int, double*);
+
+void distanceRowGeo(double, double, const double*, const double*, int, double*);
+
+distrowfunc metricDistanceRow(DIST_METRIC);
+
@@ -29,6 +29,12 @@ void pp_help(void){
     printf("\t-s, --seed  <seed_value>\tseed used for random generation (integer value)\n");
     printf("\t-tl         <timelimit_value>\tset the execution time limit (in seconds) for an instance - default 30s\n");
 	printf("\t-n, --nodes <number_of_nodes>\tnumber of nodes for the random instances\n");
+	printf("\t-p, --precision <code>\t\tprecision of the stored distances: 0 double (default), 1 float, 2 TSPLIB nint\n");
+	printf("\t-k, --candidates <k>\t\tcandidate neighbours of each node for the local searches, 0 to scan all the moves\n");
+	printf("\t-c, --candkind <code>\t\tcandidate neighbours: 0 k-nearest (default), 1 quadrant-balanced, 2 Delaunay neighbours first\n");
+	printf("\t-r, --renumber\t\t\trenumber the nodes along a Hilbert curve\n");
+	printf("\t-g, --distribution <code>\tpoints of the random instances: 0 uniform (default), 1 Gaussian clusters, 2 perturbed grid\n");
+	printf("\t-d, --ondemand\t\t\tdo not precompute the distances, compute them on demand\n");
     printf("\t-h  --help\t\t\tto reach this section\n");
     printf("\n");
 
@@ -673,7 +679,7 @@ bool runPPConfiguration(const PP_CONF* conf){
         return -1;
     }/* if */
 	
-	allocInst((*conf).set.n, &inst);
+	allocGeneratedInst(&((*conf).set), &inst);
 	allocSol((*conf).set.n, &sol);
 	
 	writeHeader(conf, outF);
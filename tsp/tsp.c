@@ -7,29 +7,23 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include <assert.h>
+#include <sys/mman.h>
 
 #include "tsp.h"
 #include "./utility/utility.h"
 #include "algorithms/refinement/refinement.h"
 #include "algorithms/nearestneighbor/nearestneighbor.h"
 #include "algorithms/random/random.h"
+#include "algorithms/greedy/greedy.h"
+#include "algorithms/spacefilling/spacefilling.h"
 #include "algorithms/cplex/cplex.h"
 #include "algorithms/cplex/matheuristics/hardfixing/hardfixing.h"
 #include "utility/utility.h"
 
-/*
-* IP x
-* OR $x rounded to the nearest integer
-* Reference:
-*	- http://comopt.ifi.uni-heidelberg.de/software/TSPLIB95/
-*	- Page 6: http://comopt.ifi.uni-heidelberg.de/software/TSPLIB95/tsp95.pdf
-*/
-int nint(double x){
-
-    return (int)(x + .5);
-
-}/* nint */
+static const char* metricNames[] = {"EUC_2D", "CEIL_2D", "ATT", "GEO", "EXPLICIT"}; /* indexed by DIST_METRIC */
 
 /*
 * IP inst instance
@@ -82,68 +76,561 @@ void ascendentSol(const TSPInstance* inst, TSPSolution* sol){
 
 }/* ascendentSol */
 
+/*
+* IP n number of nodes of the instance
+* IP layout layout of the distance matrix
+* OR number of entries of the distance matrix
+*/
+size_t distEntries(int n, DIST_LAYOUT layout){
+
+	if(layout == DIST_SQUARE)
+		return (size_t)n * n;
+
+	return triangularIndex(n, 0);
+
+}/* distEntries */
+
+/*
+* IP precision precision of the distances
+* OR size in bytes of a stored distance
+*/
+size_t distEntrySize(DIST_PRECISION precision){
+
+	if(precision == DIST_NINT)
+		return sizeof(int);
+
+	if(precision == DIST_FLOAT)
+		return sizeof(float);
+
+	return sizeof(double);
+
+}/* distEntrySize */
+
+/*
+* IP n number of nodes of the instance
+* IP layout layout the matrix would have
+* IP precision precision of the stored distances
+* OR DIST_MATRIX if the matrix fits into DIST_MATRIX_MAX_BYTES, DIST_ON_THE_FLY otherwise
+*/
+DIST_BACKEND chooseDistBackend(int n, DIST_LAYOUT layout, DIST_PRECISION precision){
+
+	if(distEntries(n, layout) > DIST_MATRIX_MAX_BYTES / distEntrySize(precision))
+		return DIST_ON_THE_FLY;
+
+	return DIST_MATRIX;
+
+}/* chooseDistBackend */
+
 /*
 * IOP inst instance to initialize $inst->dist
+* NB: the whole matrix is a single block aligned to DIST_ALIGNMENT, rows are not padded
 */
 void initDist(TSPInstance* inst){
 
-    int i;
+	size_t bytes;
+	void* aligned;
+
+	(*inst).x = malloc((*inst).dimension * sizeof(double));
+	assert((*inst).x != NULL);
+
+	(*inst).y = malloc((*inst).dimension * sizeof(double));
+	assert((*inst).y != NULL);
 
-    (*inst).dist = malloc(((*inst).dimension - 1) * sizeof(double*));
-    assert((*inst).dist != NULL);
+	(*inst).dist = NULL;
+	(*inst).fdist = NULL;
+	(*inst).idist = NULL;
+	(*inst).dist_block = NULL;
+	(*inst).map = NULL;
+	(*inst).map_bytes = 0;
 
-    for (i = 0; i < (*inst).dimension - 1; i++){
+	if((*inst).backend == DIST_ON_THE_FLY)
+		return;
 
-        (*inst).dist[i] = malloc((i + 1) * sizeof(double));
-        assert((*inst).dist[i] != NULL);
+	bytes = distEntries((*inst).dimension, (*inst).layout) * distEntrySize((*inst).precision);
 
-    }/* for */
+	(*inst).dist_block = malloc(bytes + DIST_ALIGNMENT - 1);
+	assert((*inst).dist_block != NULL);
+
+	aligned = (void*)(((uintptr_t)(*inst).dist_block + DIST_ALIGNMENT - 1) & ~((uintptr_t)DIST_ALIGNMENT - 1));
+
+	if((*inst).precision == DIST_NINT)
+		(*inst).idist = aligned;
+	else if((*inst).precision == DIST_FLOAT)
+		(*inst).fdist = aligned;
+	else
+		(*inst).dist = aligned;
 
 }/* initDist */
 
+/*
+* IP k position in the matrix
+* IP d exact distance
+* IOP inst instance whose matrix entry $k is set to $d with the instance precision
+*/
+void setDist(size_t k, double d, TSPInstance* inst){
+
+	if((*inst).precision == DIST_NINT)
+		(*inst).idist[k] = nint(d);
+	else if((*inst).precision == DIST_FLOAT)
+		(*inst).fdist[k] = d;
+	else
+		(*inst).dist[k] = d;
+
+}/* setDist */
+
+/*
+* IP first first row to compute
+* IP last row after the last to compute
+* IP rowf kernel computing a row of the matrix
+* IOP inst instance whose matrix rows [$first, $last) are computed
+* NB: row i holds the distances from node i to nodes 0..i (triangular) or 0..n-1 (square), the entry of node i
+*	itself is cleared after the kernel (the TSPLIB GEO distance of a node from itself is not 0).
+*	With DIST_DOUBLE the kernel writes straight into the matrix, otherwise into a scratch row that is then
+*	rounded to the instance precision.
+*/
+void computeDistanceRows(int first, int last, distrowfunc rowf, TSPInstance* inst){
+
+	int i, j, len;
+	size_t start;
+	double *row, *buffer = NULL;
+
+	if((*inst).precision != DIST_DOUBLE){
+		buffer = malloc((*inst).dimension * sizeof(double));
+		assert(buffer != NULL);
+	}/* if */
+
+	for(i = first; i < last; i++){
+
+		if((*inst).layout == DIST_SQUARE){
+			start = (size_t)i * (*inst).dimension;
+			len = (*inst).dimension;
+		}else{
+			start = triangularIndex(i, 0);
+			len = i + 1;
+		}/* if */
+
+		row = (buffer == NULL) ? (*inst).dist + start : buffer;
+
+		rowf((*inst).x[i], (*inst).y[i], (*inst).x, (*inst).y, len, row);
+		row[i] = 0;
+
+		if(buffer != NULL)
+			for(j = 0; j < len; j++)
+				setDist(start + j, row[j], inst);
+
+	}/* for */
+
+	free(buffer);
+
+}/* computeDistanceRows */
+
+/*
+* IOP arg DIST_CHUNK to compute
+* OR NULL
+* NB: pthread entry point
+*/
+void* computeDistanceChunk(void* arg){
+
+	DIST_CHUNK* chunk = arg;
+
+	computeDistanceRows((*chunk).first, (*chunk).last, (*chunk).rowf, (*chunk).inst);
+
+	return NULL;
+
+}/* computeDistanceChunk */
+
+/*
+* IP n number of nodes of the instance
+* IP layout layout of the distance matrix
+* IP nt number of chunks
+* OP bounds chunk t covers rows [bounds[t], bounds[t + 1]), array of $nt + 1 elements assumed to be already allocated
+* NB: the chunks hold the same number of entries, with the triangular layout row i has i + 1 entries so the
+*	rows of the last chunks are much fewer than the ones of the first
+*/
+void balancedDistanceRows(int n, DIST_LAYOUT layout, int nt, int* bounds){
+
+	int t, i = 0;
+	size_t total = distEntries(n, layout), done = 0;
+
+	bounds[0] = 0;
+
+	for(t = 1; t < nt; t++){
+
+		size_t target = total / nt * t;
+
+		while(i < n && done < target){
+			done += (layout == DIST_SQUARE) ? (size_t)n : (size_t)i + 1;
+			i++;
+		}/* while */
+
+		bounds[t] = i;
+
+	}/* for */
+
+	bounds[nt] = n;
+
+}/* balancedDistanceRows */
+
+/*
+* IOP inst, compute and store into $inst->dist all the distances
+* IP rowf kernel computing a row of the matrix
+* IP nt number of threads
+* NB: it also refreshes the coordinates arrays $inst->x, $inst->y from $inst->points, so it must be called
+*		every time the points change, whatever the backend is. A matrix mapped from a cache file or read from
+*		the file (METRIC_EXPLICIT) is left as it is.
+*	The matrix is split by balancedDistanceRows, each chunk is written only by its own thread and nothing touches
+*	the block before, so with a first touch policy its pages are placed on the node of that thread (see runChunks).
+*/
+void computeDistancesThreads(TSPInstance* inst, distrowfunc rowf, int nt){
+
+	int i, t, *bounds;
+	size_t entries = distEntries((*inst).dimension, (*inst).layout);
+	DIST_CHUNK* chunks;
+
+	for(i = 0; i < (*inst).dimension; i++){
+		(*inst).x[i] = (*inst).points[i].x;
+		(*inst).y[i] = (*inst).points[i].y;
+	}/* for */
+
+	/* a mapped matrix is read-only and already computed, an explicit one has no coordinates to compute it from */
+	if((*inst).backend == DIST_ON_THE_FLY || (*inst).map != NULL || (*inst).metric == METRIC_EXPLICIT)
+		return;
+
+	if((size_t)nt > entries / DIST_MIN_ENTRIES_PER_THREAD)
+		nt = entries / DIST_MIN_ENTRIES_PER_THREAD;
+
+	if(nt <= 1){
+		computeDistanceRows(0, (*inst).dimension, rowf, inst);
+		return;
+	}/* if */
+
+	bounds = malloc((nt + 1) * sizeof(int));
+	assert(bounds != NULL);
+
+	chunks = malloc(nt * sizeof(DIST_CHUNK));
+	assert(chunks != NULL);
+
+	balancedDistanceRows((*inst).dimension, (*inst).layout, nt, bounds);
+
+	for(t = 0; t < nt; t++){
+		chunks[t].inst = inst;
+		chunks[t].rowf = rowf;
+		chunks[t].first = bounds[t];
+		chunks[t].last = bounds[t + 1];
+	}/* for */
+
+	runChunks(chunks, sizeof(DIST_CHUNK), nt, computeDistanceChunk);
+
+	free(chunks);
+	free(bounds);
+
+}/* computeDistancesThreads */
+
 /*
 * IOP inst, compute and store into $inst->dist all the distances
+* IP rowf kernel computing a row of the matrix
+* NB: it uses all the available cores, see computeDistancesThreads
+*/
+void computeDistancesRowFunc(TSPInstance* inst, distrowfunc rowf){
+
+	computeDistancesThreads(inst, rowf, get_hardware_concurrency());
+
+}/* computeDistancesRowFunc */
+
+/*
+* IOP inst, compute and store into $inst->dist all the distances with the kernel of its metric on all the available
+*	cores, then build $inst->kdtree over the coordinates and refresh $inst->delaunay if it was computed
 */
 void computeDistances(TSPInstance* inst){
-	
-	int i, j;
 
-	for(i = 1; i < (*inst).dimension; i++)
-		for(j = 0; j < i; j++)
-	        (*inst).dist[i - 1][j] = distance(&((*inst).points[j]), &((*inst).points[i]));
+	computeDistancesRowFunc(inst, metricDistanceRow((*inst).metric));
+
+	buildKDTree((*inst).x, (*inst).y, &((*inst).kdtree));
+
+	if((*inst).delaunay.n > 0)
+		computeDelaunay(inst);
 
 }/* computeDistances */
 
+/*
+* IP inst tsp instance
+* OR true if the nearest nodes are the Euclidean nearest ones, as for EUC_2D, CEIL_2D and ATT, so that they can be
+*	taken from $inst->kdtree or compared on the squared distances of the coordinates
+*/
+bool isEuclideanNearest(const TSPInstance* inst){
+
+	return (*inst).metric == METRIC_EUC_2D || (*inst).metric == METRIC_CEIL_2D || (*inst).metric == METRIC_ATT;
+
+}/* isEuclideanNearest */
+
+/*
+* IP i node index
+* IP j node index
+* IP inst tsp instance
+* OR true if the node j is farther than the node k from the node i, ties broken by the index
+*/
+bool fartherCandidate(int i, int j, int k, const TSPInstance* inst){
+
+	double djx = (*inst).x[j] - (*inst).x[i], djy = (*inst).y[j] - (*inst).y[i];
+	double dkx = (*inst).x[k] - (*inst).x[i], dky = (*inst).y[k] - (*inst).y[i];
+	double dj = djx * djx + djy * djy, dk = dkx * dkx + dky * dky;
+
+	return dj > dk || (dj == dk && j > k);
+
+}/* fartherCandidate */
+
+/*
+* IP i node index
+* IOP inst instance whose candidate list of the node i is computed from its distances, sorted nearest first
+* NB: for the instances whose coordinates do not tell the nearest nodes, O(n k) in the worst case
+*/
+void computeCandidateListMatrix(int i, TSPInstance* inst){
+
+	int j, h, m = 0, k = (*inst).ncand;
+	int* list = (*inst).cand + (size_t)i * k;
+	double d;
+
+	for(j = 0; j < (*inst).dimension; j++){
+
+		if(j == i)
+			continue;
+
+		d = getDist(i, j, inst);
+
+		if(m == k && getDist(i, list[k - 1], inst) <= d)
+			continue;
+
+		/* insertion into the sorted list, ties keep the smaller index first */
+		for(h = (m < k) ? m++ : k - 1; h > 0 && getDist(i, list[h - 1], inst) > d; h--)
+			list[h] = list[h - 1];
+
+		list[h] = j;
+
+	}/* for */
+
+}/* computeCandidateListMatrix */
+
+/*
+* IP i node index
+* IP kind how the list is chosen
+* IP buffer array of $inst->ncand elements assumed to be already allocated
+* IOP inst instance whose candidate list of the node i is computed
+* NB: the quadrant-balanced list takes the ncand / 4 nearest nodes of each quadrant around i, the Delaunay one the
+*	(at most ncand) nearest Delaunay neighbours of i, so that clustered instances still get candidates towards the
+*	other clusters. Both fill the places left with the nearest nodes not taken yet and end up sorted nearest first.
+*	The nearest nodes are the Euclidean ones, that are also the nearest for CEIL_2D and ATT. An explicit instance,
+*	and a GEO one with the matrix, gets the nearest nodes from its distances instead, whatever $kind is.
+*/
+void computeCandidateList(int i, CAND_KIND kind, int* buffer, TSPInstance* inst){
+
+	int q, j, h, m = 0, k = (*inst).ncand, found;
+	int* list = (*inst).cand + (size_t)i * k;
+
+	if((*inst).metric == METRIC_EXPLICIT || ((*inst).metric == METRIC_GEO && (*inst).backend == DIST_MATRIX)){
+		computeCandidateListMatrix(i, inst);
+		return;
+	}/* if */
+
+	if(kind == CAND_KNN){
+		kdKNearest(&((*inst).kdtree), NULL, (*inst).x[i], (*inst).y[i], i, k, list);
+		return;
+	}/* if */
+
+	if(kind == CAND_QUADRANT)
+		for(q = 0; q < 4; q++)
+			m += kdKNearestQuadrant(&((*inst).kdtree), NULL, (*inst).x[i], (*inst).y[i], i, q, k / 4, list + m);
+	else
+		for(j = (*inst).delaunay.first[i]; j < (*inst).delaunay.first[i + 1] && m < k; j++)
+			list[m++] = (*inst).delaunay.adj[j];
+
+	found = kdKNearest(&((*inst).kdtree), NULL, (*inst).x[i], (*inst).y[i], i, k, buffer);
+
+	for(j = 0; j < found && m < k; j++){
+
+		for(h = 0; h < m && list[h] != buffer[j]; h++);
+
+		if(h == m)
+			list[m++] = buffer[j];
+
+	}/* for */
+
+	/* insertion sort, the list is short */
+	for(j = 1; j < m; j++)
+		for(h = j; h > 0 && fartherCandidate(i, list[h - 1], list[h], inst); h--)
+			swapInt(&(list[h - 1]), &(list[h]));
+
+}/* computeCandidateList */
+
+/*
+* IOP arg CAND_CHUNK to compute
+* OR NULL
+* NB: pthread entry point
+*/
+void* computeCandidateChunk(void* arg){
+
+	CAND_CHUNK* chunk = arg;
+	int i, *buffer = malloc((*(*chunk).inst).ncand * sizeof(int));
+
+	assert(buffer != NULL);
+
+	for(i = (*chunk).first; i < (*chunk).last; i++)
+		computeCandidateList(i, (*chunk).kind, buffer, (*chunk).inst);
+
+	free(buffer);
+
+	return NULL;
+
+}/* computeCandidateChunk */
+
+/*
+* IOP inst instance whose Delaunay triangulation is computed from $inst->x, $inst->y, O(n log n)
+*/
+void computeDelaunay(TSPInstance* inst){
+
+	freeDelaunay(&((*inst).delaunay));
+
+	buildDelaunay((*inst).dimension, (*inst).x, (*inst).y, &((*inst).delaunay));
+
+}/* computeDelaunay */
+
+/*
+* IP k number of candidate neighbours of each node, capped to n - 1, 0 to drop the lists
+* IP kind how the lists are chosen (see computeCandidateList)
+* IP nt number of threads
+* IOP inst instance whose candidate lists are computed, its k-d tree must be already built (see computeDistances)
+* NB: the lists are stored in one contiguous block, the nodes are split in equal chunks run by runChunks.
+*	With CAND_DELAUNAY the triangulation is computed first if it is missing.
+*/
+void computeCandidatesThreads(int k, CAND_KIND kind, int nt, TSPInstance* inst){
+
+	int t, n = (*inst).dimension;
+	CAND_CHUNK* chunks;
+
+	free((*inst).cand);
+	(*inst).cand = NULL;
+	(*inst).ncand = (k < n - 1) ? k : n - 1;
+
+	if((*inst).ncand <= 0){
+		(*inst).ncand = 0;
+		return;
+	}/* if */
+
+	(*inst).cand = malloc((size_t)n * (*inst).ncand * sizeof(int));
+	assert((*inst).cand != NULL);
+
+	if(kind == CAND_DELAUNAY && (*inst).metric != METRIC_EXPLICIT && (*inst).delaunay.n != n)
+		computeDelaunay(inst);
+
+	if(nt > n / CAND_MIN_NODES_PER_THREAD)
+		nt = n / CAND_MIN_NODES_PER_THREAD;
+
+	if(nt < 1)
+		nt = 1;
+
+	chunks = malloc(nt * sizeof(CAND_CHUNK));
+	assert(chunks != NULL);
+
+	for(t = 0; t < nt; t++){
+		chunks[t].inst = inst;
+		chunks[t].kind = kind;
+		chunks[t].first = (int)((long)n * t / nt);
+		chunks[t].last = (int)((long)n * (t + 1) / nt);
+	}/* for */
+
+	runChunks(chunks, sizeof(CAND_CHUNK), nt, computeCandidateChunk);
+
+	free(chunks);
+
+}/* computeCandidatesThreads */
+
+/*
+* IP k number of candidate neighbours of each node, 0 to drop the lists
+* IP kind how the lists are chosen
+* IOP inst instance whose candidate lists are computed on all the available cores, see computeCandidatesThreads
+*/
+void computeCandidates(int k, CAND_KIND kind, TSPInstance* inst){
+
+	computeCandidatesThreads(k, kind, get_hardware_concurrency(), inst);
+
+}/* computeCandidates */
+
 /*
 * IP n number of nodes of the instance
+* IP backend distance backend
+* IP layout layout of the distance matrix, ignored with DIST_ON_THE_FLY
+* IP precision precision of the distances
 * IP inst instance to initialize
 */
-void allocInst(int n, TSPInstance* inst){
+void allocInstBackend(int n, DIST_BACKEND backend, DIST_LAYOUT layout, DIST_PRECISION precision, TSPInstance* inst){
 
     (*inst).dimension = n;
+	(*inst).metric = METRIC_EUC_2D;
+	(*inst).backend = backend;
+	(*inst).layout = layout;
+	(*inst).precision = precision;
     (*inst).points = malloc((*inst).dimension * sizeof(Point2D));
     
 	assert((*inst).points != NULL);
 
 	initDist(inst);
 
-}/* allocInst */
+	allocKDTree(n, &((*inst).kdtree));
+
+	(*inst).orig = NULL;
+
+	(*inst).delaunay.n = 0;
+	(*inst).delaunay.tri = (*inst).delaunay.first = (*inst).delaunay.adj = NULL;
+
+	(*inst).ncand = 0;
+	(*inst).cand = NULL;
+
+}/* allocInstBackend */
 
 /*
-* IOP inst instance to free $inst->dist
+* IP n number of nodes of the instance
+* IP layout layout of the distance matrix
+* IP inst instance to initialize
+* NB: the backend is chosen by chooseDistBackend
 */
-void freeDist(TSPInstance* inst){
+void allocInstLayout(int n, DIST_LAYOUT layout, TSPInstance* inst){
+
+	allocInstBackend(n, chooseDistBackend(n, layout, DIST_DOUBLE), layout, DIST_DOUBLE, inst);
+
+}/* allocInstLayout */
+
+/*
+* IP n number of nodes of the instance
+* IP precision precision of the distances
+* IP inst instance to initialize
+* NB: the backend is chosen by chooseDistBackend
+*/
+void allocInstPrecision(int n, DIST_PRECISION precision, TSPInstance* inst){
+
+	allocInstBackend(n, chooseDistBackend(n, DIST_TRIANGULAR, precision), DIST_TRIANGULAR, precision, inst);
+
+}/* allocInstPrecision */
+
+/*
+* IP n number of nodes of the instance
+* IP inst instance to initialize
+*/
+void allocInst(int n, TSPInstance* inst){
 
-    int i;
+	allocInstLayout(n, DIST_TRIANGULAR, inst);
 
-    if((*inst).dimension > 1){
+}/* allocInst */
 
-        for (i = 0; i < (*inst).dimension - 1; i++)
-            free((*inst).dist[i]);
+/*
+* IOP inst instance to free $inst->dist
+*/
+void freeDist(TSPInstance* inst){
 
-        free((*inst).dist);
+	if((*inst).map != NULL)
+		munmap((*inst).map, (*inst).map_bytes);
 
-    }/* if */
+	free((*inst).dist_block);
+	free((*inst).y);
+	free((*inst).x);
 
 }/* freeDist */
 
@@ -153,6 +640,10 @@ void freeDist(TSPInstance* inst){
 void freeInst(TSPInstance* inst){
     free(inst->points);
 	freeDist(inst);
+	freeKDTree(&((*inst).kdtree));
+	freeDelaunay(&((*inst).delaunay));
+	free((*inst).cand);
+	free((*inst).orig);
 }/* freeInst */
 
 /*
@@ -200,6 +691,84 @@ void freeSSol(TSPSSolution* ssol){
 
 }/* freeSSol */
 
+/*
+* IP n number of nodes of the instance
+* OP sc checker to initialize, no node met yet
+*/
+void allocSolChecker(int n, SOL_CHECKER* sc){
+
+	(*sc).n = n;
+	(*sc).gen = 0;
+
+	(*sc).stamp = calloc(n, sizeof(unsigned int));
+	assert((*sc).stamp != NULL);
+
+}/* allocSolChecker */
+
+/*
+* IOP sc checker to free memory
+*/
+void freeSolChecker(SOL_CHECKER* sc){
+	free((*sc).stamp);
+}/* freeSolChecker */
+
+/*
+* IP n number of nodes of the instance
+* OP tour tour to initialize, TOUR_ARRAY
+*/
+void allocTour(int n, TSPTour* tour){
+
+	allocTourKind(n, TOUR_ARRAY, tour);
+
+}/* allocTour */
+
+/*
+* IP n number of nodes of the instance
+* IP kind representation of the tour
+* OP tour tour to initialize
+*/
+void allocTourKind(int n, TOUR_KIND kind, TSPTour* tour){
+
+	(*tour).n = n;
+	(*tour).kind = kind;
+	(*tour).path = NULL;
+	(*tour).pos = NULL;
+
+	if(kind == TOUR_TWO_LEVEL){
+		allocTwoLevel(n, &((*tour).tl));
+		return;
+	}/* if */
+
+	(*tour).path = malloc(n * sizeof(int));
+	assert((*tour).path != NULL);
+
+	(*tour).pos = malloc(n * sizeof(int));
+	assert((*tour).pos != NULL);
+
+}/* allocTourKind */
+
+/*
+* IP n number of nodes of the instance
+* OR representation of the tour the local searches use for $n nodes
+* NB: below TOUR_TWO_LEVEL_MIN_NODES the O(n) reversals of the array are cheaper than the indirections of the list
+*/
+TOUR_KIND getTourKind(int n){
+	return (n >= TOUR_TWO_LEVEL_MIN_NODES) ? TOUR_TWO_LEVEL : TOUR_ARRAY;
+}/* getTourKind */
+
+/*
+* IOP tour tour to free memory
+*/
+void freeTour(TSPTour* tour){
+
+	if((*tour).kind == TOUR_TWO_LEVEL)
+		freeTwoLevel(&((*tour).tl));
+
+	free((*tour).pos);
+	free((*tour).path);
+
+}/* freeTour */
+
 /*
 * IP inst instance to print
 */
@@ -210,16 +779,84 @@ void printInst(const TSPInstance* inst){
     printf("Instance:\n");
     printf("\tName: %s\n", inst->name);
     printf("\tDimension: %d\n", inst->dimension);
+	printf("\tMetric: %s\n", metricNames[inst->metric]);
+	printf("\tDistances: %s\n", inst->backend == DIST_ON_THE_FLY ? "computed on demand" : "precomputed matrix");
     printf("\tNodes:\n");
     for(i = 0; i < inst->dimension; i++)
         if(i < (POINTS_TO_PRINT/2) || i >= (inst->dimension - POINTS_TO_PRINT/2))
-            printf("\t\t%.3d %lf %lf\n", i + 1, inst->points[i].x, inst->points[i].y);
+            printf("\t\t%.3d %lf %lf\n", getOriginalId(i, inst) + 1, inst->points[i].x, inst->points[i].y);
         else if ( i == (inst->dimension - POINTS_TO_PRINT/2 - 1))
             printf("\t\t\t...\n");
     printf("\n");
 
 }/* printInst */
 
+/*
+* IP inst tsp instance
+* IP sol solution
+* OV cost and tour of the solution, with the ids the nodes had when the instance was read/generated
+*/
+void printSol(const TSPInstance* inst, const TSPSolution* sol){
+
+	int i;
+
+	printf("Solution:\n");
+	printf("\tCost: %lf\n", (*sol).val);
+	printf("\tTour:\n");
+	for(i = 0; i < (*inst).dimension; i++)
+		if(i < (POINTS_TO_PRINT/2) || i >= ((*inst).dimension - POINTS_TO_PRINT/2))
+			printf("\t\t%.3d\n", getOriginalId((*sol).path[i], inst) + 1);
+		else if(i == ((*inst).dimension - POINTS_TO_PRINT/2 - 1))
+			printf("\t\t\t...\n");
+	printf("\n");
+
+}/* printSol */
+
+/*
+* IOP inst instance whose nodes are renumbered in the order the Hilbert curve over their bounding box visits them,
+*	$inst->orig keeps the ids they had before
+* NB: it must be called after the points are set and before computeDistances, that computes everything else on the
+*	new numbering. Nodes close in space get close ids, so the rows of the matrix and the points read one after the
+*	other along a tour are mostly close in memory. An explicit instance is left as it is, its matrix is already read.
+*/
+void renumberHilbert(TSPInstance* inst){
+
+	int i, n = (*inst).dimension, *order;
+	Point2D* points;
+
+	if((*inst).metric == METRIC_EXPLICIT)
+		return;
+
+	order = malloc(n * sizeof(int));
+	assert(order != NULL);
+
+	points = malloc(n * sizeof(Point2D));
+	assert(points != NULL);
+
+	if((*inst).orig == NULL){
+		(*inst).orig = malloc(n * sizeof(int));
+		assert((*inst).orig != NULL);
+	}/* if */
+
+	for(i = 0; i < n; i++){
+		(*inst).x[i] = (*inst).points[i].x;
+		(*inst).y[i] = (*inst).points[i].y;
+	}/* for */
+
+	hilbertOrder(n, (*inst).x, (*inst).y, order);
+
+	for(i = 0; i < n; i++){
+		points[i] = (*inst).points[order[i]];
+		(*inst).orig[i] = order[i];
+	}/* for */
+
+	free((*inst).points);
+	(*inst).points = points;
+
+	free(order);
+
+}/* renumberHilbert */
+
 /*
 * Print algorithm legend.
 */
@@ -228,6 +865,8 @@ void algorithmLegend(void){
     printf("Available algorithms:\n");
     printf("\t- Code: %d, Algorithm: Just a random solution\n", RANDOM);
     printf("\t- Code: %d, Algorithm: Nearest neighbor search\n", NEAREST_NEIGHBOR);
+	printf("\t- Code: %d, Algorithm: Greedy edge (multi-fragment) construction\n", GREEDY);
+	printf("\t- Code: %d, Algorithm: Hilbert curve order of the nodes\n", HILBERT_CURVE);
 	printf("\t- Code: %d, Algorithm: CPLEX exact method\n", CPLEX);
 	printf("\t- Code: %d, Algorithm: MATHEURISTIC method\n", MATHEURISTIC);
     printf("\n");
@@ -269,6 +908,12 @@ bool offline_run(OFFLINE_ALGORITHM alg, const TSPInstance* inst, TSPSolution* so
 	        if((et = NNRunConfiguration(BEST_START, set, inst, sol)) == -1)
 				return true;
 	        break;
+		case O_GREEDY:
+			et = greedySol(inst, sol);
+			break;
+		case O_HILBERT_CURVE:
+			et = hilbertSol(inst, sol);
+			break;
 	    default:
 	        printf("Error: Algorithm code not found.\n\n");
 	        return true;
@@ -310,6 +955,12 @@ bool run(ALGORITHM alg, const TSPInstance* inst, TSPSolution* sol, const Setting
 	        if((et = nearestNeighbor(set, inst, sol)) == -1)
 				return true;
 	        break;
+		case GREEDY:
+			et = greedySol(inst, sol);
+			break;
+		case HILBERT_CURVE:
+			et = hilbertSol(inst, sol);
+			break;
 		case CPLEX:
 			return optimize(set, inst, sol);
 		case MATHEURISTIC:
@@ -333,21 +984,6 @@ bool run(ALGORITHM alg, const TSPInstance* inst, TSPSolution* sol, const Setting
 
 }/* run */
 
-/*
-* IP first node index
-* IP second node index
-* IP inst tsp instance
-* OR distance between nodes i and j
-*/
-double getDist(int i, int j, const TSPInstance* inst){
-
-	if(i == j)
-		return 0;
-	
-	return (i < j) ? (*inst).dist[j - 1][i] : (*inst).dist[i - 1][j];
-
-}/* getDist */
-
 /*
 * Checks whether the solution is valid.
 * IP inst tsp instance
@@ -363,6 +999,27 @@ bool checkSol(const TSPInstance* inst, const TSPSolution* sol){
 
 }/* checkSol */
 
+/*
+* IP inst tsp instance
+* IP sol solution we want to check validity of
+* IOP sc checker of $inst->dimension nodes, reused from a check to the next
+* OR true if $sol visits each node once (and, with VERIFY_SOLUTIONS, if its cost is right)
+* NB: no allocation, O(n). The cost is kept up to date by the moves, it is computed from scratch only with
+*	VERIFY_SOLUTIONS (make VERIFY=1 or DEBUG=1).
+*/
+bool checkSolChecker(const TSPInstance* inst, const TSPSolution* sol, SOL_CHECKER* sc){
+
+	if(!isDistinctChecker((*sol).path, sc))
+		return false;
+
+#ifdef VERIFY_SOLUTIONS
+	return isEqual((*sol).val, getSolCost(inst, sol));
+#else
+	return true;
+#endif
+
+}/* checkSolChecker */
+
 /*
 * IP inst tsp instance
 * IP source solution we want to copy
@@ -424,15 +1081,45 @@ bool isDistinct(int n, int* arr){
 
 }/* isDistinct */
 
+/*
+* IP arr array of $sc->n elements
+* IOP sc checker, its generation moves on
+* OR true if each element in [0, $sc->n) appears once in $arr, as isDistinct
+* NB: the nodes met are stamped with a new generation instead of counted in a zeroed array, so nothing is allocated
+*	or cleared but when the generation wraps around
+*/
+bool isDistinctChecker(const int* arr, SOL_CHECKER* sc){
+
+	int i;
+
+	if(++(*sc).gen == 0){
+		memset((*sc).stamp, 0, (*sc).n * sizeof(unsigned int));
+		(*sc).gen = 1;
+	}/* if */
+
+	for(i = 0; i < (*sc).n; i++){
+
+		if(arr[i] < 0 || arr[i] >= (*sc).n || (*sc).stamp[arr[i]] == (*sc).gen)
+			return false;
+
+		(*sc).stamp[arr[i]] = (*sc).gen;
+
+	}/* for */
+
+	return true;
+
+}/* isDistinctChecker */
+
 /*
 * IP inst tsp instance
 * IP temp current solution found
 * IOP sol best solution 
+* IOP sc checker of the caller, see checkSolChecker
 * OR true if the incumbent is updated, false otherwise
 */
-bool updateIncumbentSol(const TSPInstance* inst, const TSPSolution* temp, TSPSolution* sol){
+bool updateIncumbentSol(const TSPInstance* inst, const TSPSolution* temp, TSPSolution* sol, SOL_CHECKER* sc){
 
-    if((*temp).val < (*sol).val && checkSol(inst, temp)){
+    if((*temp).val < (*sol).val && checkSolChecker(inst, temp, sc)){
 		cpSol(inst, temp, sol);
 		return true;
 	}/* if */
@@ -456,3 +1143,160 @@ void convertSSol(const TSPInstance* inst, const TSPSSolution* in, TSPSolution* o
 		(*out).path[i] = (curr = (*in).succ[curr]);
 
 }/* convertSSol */
+
+/*
+* IP in solution in path representation
+* OP out the same tour, with the positions of its nodes
+* This method assumes $out is already allocated
+*/
+void convertSolTour(const TSPSolution* in, TSPTour* out){
+
+	int i;
+
+	(*out).val = (*in).val;
+
+	if((*out).kind == TOUR_TWO_LEVEL){
+		twoLevelFromPath((*in).path, &((*out).tl));
+		return;
+	}/* if */
+
+	for(i = 0; i < (*out).n; i++){
+		(*out).path[i] = (*in).path[i];
+		(*out).pos[(*in).path[i]] = i;
+	}/* for */
+
+}/* convertSolTour */
+
+/*
+* IP in tour
+* OP out the same tour in path representation
+* This method assumes $out is already allocated
+*/
+void convertTourSol(const TSPTour* in, TSPSolution* out){
+
+	int i;
+
+	(*out).val = (*in).val;
+
+	if((*in).kind == TOUR_TWO_LEVEL){
+		twoLevelToPath(&((*in).tl), (*out).path);
+		return;
+	}/* if */
+
+	for(i = 0; i < (*in).n; i++)
+		(*out).path[i] = (*in).path[i];
+
+}/* convertTourSol */
+
+/*
+* IP in solution in successor representation
+* OP out the same tour starting from node 0, with the positions of its nodes
+* This method assumes $out is already allocated
+* NB: a two-level list is built from the path written in its own storage
+*/
+void convertSSolTour(const TSPSSolution* in, TSPTour* out){
+
+	int i, curr = 0;
+	int* path = ((*out).kind == TOUR_TWO_LEVEL) ? (*out).tl.storage : (*out).path;
+
+	(*out).val = (*in).val;
+
+	for(i = 0; i < (*out).n; i++){
+		path[i] = curr;
+		if((*out).kind == TOUR_ARRAY)
+			(*out).pos[curr] = i;
+		curr = (*in).succ[curr];
+	}/* for */
+
+	if((*out).kind == TOUR_TWO_LEVEL)
+		twoLevelFromPath(path, &((*out).tl));
+
+}/* convertSSolTour */
+
+/*
+* IP in tour
+* OP out the same tour in successor representation
+* This method assumes $out is already allocated
+*/
+void convertTourSSol(const TSPTour* in, TSPSSolution* out){
+
+	int i;
+
+	(*out).val = (*in).val;
+
+	for(i = 0; i < (*in).n; i++)
+		(*out).succ[i] = tourNext(i, in);
+
+}/* convertTourSSol */
+
+/*
+* IP i first index of $tour->path to reverse
+* IP j last index of $tour->path to reverse, i <= j
+* IOP tour tour whose path[i..j] is reversed, positions kept updated
+* NB: TOUR_ARRAY only, the cost is not updated, O(j - i)
+*/
+void reverseTour(int i, int j, TSPTour* tour){
+
+	invertArray(i, j, (*tour).path);
+
+	for(; i <= j; i++)
+		(*tour).pos[(*tour).path[i]] = i;
+
+}/* reverseTour */
+
+/*
+* IP a first node of the path
+* IP b last node of the path
+* IOP tour tour whose path from $a forward to $b is reversed
+* NB: reversing the rest of the tour gives the same cycle. An array reverses the shorter of the two sides (through the
+*	end of the array if needed), a two-level list the path unless it goes through the end of the segments. The whole
+*	tour is left as it is. The cost is not updated.
+*/
+void reverseTourPath(int a, int b, TSPTour* tour){
+
+	int n = (*tour).n, i, j, k;
+
+	if(tourNext(b, tour) == a)
+		return;
+
+	if((*tour).kind == TOUR_TWO_LEVEL){
+		twoLevelReverse(a, b, &((*tour).tl));
+		return;
+	}/* if */
+
+	i = (*tour).pos[a];
+	j = (*tour).pos[b];
+
+	if(2 * ((j - i + n) % n + 1) > n){ /* the rest of the tour is shorter */
+		k = i;
+		i = (j + 1) % n;
+		j = (k + n - 1) % n;
+	}/* if */
+
+	invertArrayCyclic(n, i, j, (*tour).path);
+
+	for(k = i; k != j; k = (k + 1) % n)
+		(*tour).pos[(*tour).path[k]] = k;
+
+	(*tour).pos[(*tour).path[j]] = j;
+
+}/* reverseTourPath */
+
+/*
+* IP tour tour
+* OR true if the tour visits each node once and its positions (or segments) are consistent
+*/
+bool checkTour(const TSPTour* tour){
+
+	int i;
+
+	if((*tour).kind == TOUR_TWO_LEVEL)
+		return checkTwoLevel(&((*tour).tl));
+
+	for(i = 0; i < (*tour).n; i++)
+		if((*tour).path[i] < 0 || (*tour).path[i] >= (*tour).n || (*tour).pos[(*tour).path[i]] != i)
+			return false;
+
+	return true;
+
+}/* checkTour */
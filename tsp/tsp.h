@@ -7,20 +7,80 @@
 
 #pragma once
 #include <stdbool.h>
+#include <stddef.h>
+#include <math.h>
 
 #include "point/point.h"
+#include "point/kdtree/kdtree.h"
+#include "point/delaunay/delaunay.h"
+#include "point/hilbert/hilbert.h"
+#include "twolevel/twolevel.h"
 #include "input/settings/settings.h"
 
 #define MAX_NAME_LENGTH 64
 #define POINTS_TO_PRINT 10
+#define DIST_ALIGNMENT 64 /* bytes, one cache line */
+#define DIST_MATRIX_MAX_BYTES (1UL << 30) /* above this size the distances are computed on demand */
+#define DIST_MIN_ENTRIES_PER_THREAD (1 << 16) /* smaller matrices are not worth a thread */
+#define CAND_MIN_NODES_PER_THREAD 1024 /* smaller chunks of candidate lists are not worth a thread */
+#define TOUR_TWO_LEVEL_MIN_NODES 10000 /* from this size the local searches keep the tour in a two-level list */
+
+typedef enum {
+	DIST_MATRIX,		/* distances precomputed once into $dist */
+	DIST_ON_THE_FLY		/* no matrix, distances computed from the coordinates at each request */
+} DIST_BACKEND;
+
+typedef enum {
+	DIST_TRIANGULAR,	/* lower triangle (diagonal included) packed row by row, n(n+1)/2 entries */
+	DIST_SQUARE			/* full n x n row-major matrix, twice the memory but no index arithmetic */
+} DIST_LAYOUT;
+
+typedef enum {
+	DIST_DOUBLE,		/* distances stored as double */
+	DIST_FLOAT,			/* distances stored as float, half the memory */
+	DIST_NINT			/* distances rounded to the nearest integer as TSPLIB does, stored as int */
+} DIST_PRECISION;
+
+typedef enum {
+	CAND_KNN,			/* the k nearest nodes */
+	CAND_QUADRANT,		/* the k / 4 nearest nodes of each quadrant, then the nearest ones */
+	CAND_DELAUNAY		/* the Delaunay neighbours nearest first, then the nearest nodes */
+} CAND_KIND;
 
 typedef struct {
     char name[MAX_NAME_LENGTH];
     int dimension;
     Point2D* points;
-	double** dist;	/* dist  := precomputed distances among nodes */
+	int* orig;			/* orig   := orig[i] id the node i had when the instance was read/generated, NULL if not renumbered */
+	double *x, *y;		/* x, y   := coordinates of $points split in two arrays (SoA) */
+	DIST_METRIC metric;	/* metric := how the distances between the nodes are defined */
+	DIST_BACKEND backend;	/* backend := where getDist takes the distances from */
+	DIST_LAYOUT layout;	/* layout := how $dist is packed, meaningful only with DIST_MATRIX */
+	DIST_PRECISION precision;	/* precision := type of the stored distances, the one of the three arrays below in use */
+	double* dist;		/* dist   := precomputed distances among nodes, one DIST_ALIGNMENT aligned block */
+	float* fdist;		/* fdist  := as $dist, with DIST_FLOAT */
+	int* idist;			/* idist  := as $dist, with DIST_NINT */
+	void* dist_block;	/* dist_block := block returned by the allocator, the matrix in use points inside it */
+	void* map;			/* map    := read-only mapping of a cache file the matrix in use points inside, NULL if none */
+	size_t map_bytes;	/* map_bytes := size of $map */
+	KDTree kdtree;		/* kdtree := k-d tree over $x, $y, built by computeDistances */
+	DelaunayGraph delaunay;	/* delaunay := Delaunay triangulation of $x, $y, built by computeDelaunay (n = 0 until then) */
+	int ncand;			/* ncand  := number of candidate neighbours of each node, 0 if there are none */
+	int* cand;			/* cand   := cand[i * ncand .. (i + 1) * ncand) candidate neighbours of the node i, nearest first */
 } TSPInstance;
 
+typedef struct {
+	TSPInstance* inst;	/* inst  := instance whose matrix is computed */
+	distrowfunc rowf;	/* rowf  := kernel computing a row */
+	int first, last;	/* first, last := the chunk covers the rows [first, last) */
+} DIST_CHUNK;
+
+typedef struct {
+	TSPInstance* inst;	/* inst  := instance whose candidate lists are computed */
+	CAND_KIND kind;		/* kind  := how the lists are chosen */
+	int first, last;	/* first, last := the chunk covers the nodes [first, last) */
+} CAND_CHUNK;
+
 typedef struct {
     int* path;	/* path := array containing the indexes of the nodes of the instance in the order they have to be visited */
     double val;	/* val  := value of the cost of the solution $path */
@@ -31,10 +91,32 @@ typedef struct {
     double val;	/* val  := value of the cost of the solution $path */
 } TSPSSolution;
 
+typedef struct {
+	unsigned int* stamp;	/* stamp := stamp[v] last generation that met the node v */
+	unsigned int gen;		/* gen   := generation of the current check, the stamps are cleared only when it wraps */
+	int n;					/* n     := number of nodes */
+} SOL_CHECKER;
+
+typedef enum {
+	TOUR_ARRAY,		/* path and positions of the nodes, O(1) queries and O(n) reversals */
+	TOUR_TWO_LEVEL	/* two-level list, O(1) queries and O(sqrt(n)) reversals */
+} TOUR_KIND;
+
+typedef struct {
+	TOUR_KIND kind;	/* kind := representation of the tour */
+	int* path;		/* path := nodes in the order they are visited, as in TSPSolution (TOUR_ARRAY only) */
+	int* pos;		/* pos  := pos[v] index of the node v in $path, pos[path[i]] = i (TOUR_ARRAY only) */
+	TwoLevelList tl;/* tl   := two-level list of the tour (TOUR_TWO_LEVEL only) */
+	int n;			/* n    := number of nodes */
+	double val;		/* val  := value of the cost of the tour */
+} TSPTour;
+
 typedef enum {
     /* HEURISTICS */
 	RANDOM,
     NEAREST_NEIGHBOR,
+	GREEDY,
+	HILBERT_CURVE,
 	__END_HEURISTIC,
 	/* EXACTS */
 	CPLEX,
@@ -58,12 +140,28 @@ typedef enum {
 	O_NEAREST_NEIGHBOR_START_FIRST_NODE,
     O_NEAREST_NEIGHBOR_START_RANDOM_NODE,
 	O_NEAREST_NEIGHBOR_BEST_START,
+	O_GREEDY,
+	O_HILBERT_CURVE,
 	O___END_HEURISTIC//,
 	// O_CPLEX
 } OFFLINE_ALGORITHM;
 
 void allocInst(int, TSPInstance*);
 
+void allocInstLayout(int, DIST_LAYOUT, TSPInstance*);
+
+void allocInstPrecision(int, DIST_PRECISION, TSPInstance*);
+
+void allocInstBackend(int, DIST_BACKEND, DIST_LAYOUT, DIST_PRECISION, TSPInstance*);
+
+DIST_BACKEND chooseDistBackend(int, DIST_LAYOUT, DIST_PRECISION);
+
+size_t distEntries(int, DIST_LAYOUT);
+
+size_t distEntrySize(DIST_PRECISION);
+
+void setDist(size_t, double, TSPInstance*);
+
 void allocSol(int, TSPSolution*);
 
 void allocSSol(int, TSPSSolution*);
@@ -74,16 +172,42 @@ void freeSol(TSPSolution*);
 
 void freeSSol(TSPSSolution*);
 
+void allocSolChecker(int, SOL_CHECKER*);
+
+void freeSolChecker(SOL_CHECKER*);
+
+void allocTour(int, TSPTour*);
+
+void allocTourKind(int, TOUR_KIND, TSPTour*);
+
+TOUR_KIND getTourKind(int);
+
+void freeTour(TSPTour*);
+
 void computeDistances(TSPInstance*);
 
+void computeDistancesRowFunc(TSPInstance*, distrowfunc);
+
+void computeDistancesThreads(TSPInstance*, distrowfunc, int);
+
+void computeDelaunay(TSPInstance*);
+
+bool isEuclideanNearest(const TSPInstance*);
+
+void computeCandidates(int, CAND_KIND, TSPInstance*);
+
+void computeCandidatesThreads(int, CAND_KIND, int, TSPInstance*);
+
 void printInst(const TSPInstance*);
 
+void printSol(const TSPInstance*, const TSPSolution*);
+
+void renumberHilbert(TSPInstance*);
+
 void algorithmLegend(void);
 
 bool run(ALGORITHM, const TSPInstance*, TSPSolution*, const Settings*);
 
-double getDist(int, int, const TSPInstance*);
-
 void ascendentSol(const TSPInstance*, TSPSolution*);
 
 double getSolCost(const TSPInstance*, const TSPSolution*);
@@ -94,12 +218,205 @@ bool checkSol(const TSPInstance*, const TSPSolution*);
 
 bool isDistinct(int, int*);
 
+bool isDistinctChecker(const int*, SOL_CHECKER*);
+
+bool checkSolChecker(const TSPInstance*, const TSPSolution*, SOL_CHECKER*);
+
 void cpSol(const TSPInstance*, const TSPSolution*, TSPSolution*);
 
 void cpSSol(const TSPInstance*, const TSPSSolution*, TSPSSolution*);
 
-bool updateIncumbentSol(const TSPInstance*, const TSPSolution*, TSPSolution*);
+bool updateIncumbentSol(const TSPInstance*, const TSPSolution*, TSPSolution*, SOL_CHECKER*);
 
 void convertSSol(const TSPInstance*, const TSPSSolution*, TSPSolution*);
 
+void convertSolTour(const TSPSolution*, TSPTour*);
+
+void convertTourSol(const TSPTour*, TSPSolution*);
+
+void convertSSolTour(const TSPSSolution*, TSPTour*);
+
+void convertTourSSol(const TSPTour*, TSPSSolution*);
+
+void reverseTour(int, int, TSPTour*);
+
+void reverseTourPath(int, int, TSPTour*);
+
+bool checkTour(const TSPTour*);
+
 bool offline_run_refinement(OFFLINE_ALGORITHM, REFINEMENT_ALGORITHM, const TSPInstance*, TSPSolution*, const Settings*);
+
+/*
+* IP x
+* OR $x rounded to the nearest integer
+* Reference:
+*	- http://comopt.ifi.uni-heidelberg.de/software/TSPLIB95/
+*	- Page 6: http://comopt.ifi.uni-heidelberg.de/software/TSPLIB95/tsp95.pdf
+*/
+static inline int nint(double x){
+    return (int)(x + .5);
+}/* nint */
+
+/*
+* IP d exact distance
+* IP precision precision of the distances of the instance
+* OR $d as it is stored with $precision
+*/
+static inline double roundDist(double d, DIST_PRECISION precision){
+
+	if(precision == DIST_NINT)
+		return nint(d);
+
+	if(precision == DIST_FLOAT)
+		return (float)d;
+
+	return d;
+
+}/* roundDist */
+
+/*
+* IP i row index, assumed i >= j
+* IP j column index
+* OR position of the entry (i, j) in the packed lower triangle
+*/
+static inline size_t triangularIndex(int i, int j){
+	return (size_t)i * (i + 1) / 2 + j;
+}/* triangularIndex */
+
+/*
+* IP first node index
+* IP second node index
+* IP inst tsp instance
+* OR position of the distance between nodes i and j in the matrix of $inst
+* NB: the diagonal is stored (as 0) so that no i == j test is needed, the min/max compile to conditional moves
+*/
+static inline size_t distIndex(int i, int j, const TSPInstance* inst){
+
+	if((*inst).layout == DIST_SQUARE)
+		return (size_t)i * (*inst).dimension + j;
+
+	return triangularIndex(i > j ? i : j, i > j ? j : i);
+
+}/* distIndex */
+
+/*
+* IP first node index
+* IP second node index
+* IP inst tsp instance
+* OR distance between nodes i and j
+* NB: whatever the storage precision is, the value is returned as double so that costs are summed in double.
+*	It is not branch-free, it tests the backend, the precision and the layout of $inst: the default matrix (doubles
+*	in a lower triangle) is tested first, the tests are the same at every call so they are well predicted and only
+*	the min/max of the indexes are left, as conditional moves. The distances computed on demand use the pair
+*	kernels of point.h, inlined here, so there is no call per distance.
+*/
+static inline double getDist(int i, int j, const TSPInstance* inst){
+
+	if((*inst).backend == DIST_MATRIX && (*inst).precision == DIST_DOUBLE && (*inst).layout == DIST_TRIANGULAR)
+		return (*inst).dist[triangularIndex(i > j ? i : j, i > j ? j : i)];
+
+	if((*inst).backend == DIST_ON_THE_FLY){
+
+		double px = (*inst).x[i], py = (*inst).y[i], qx = (*inst).x[j], qy = (*inst).y[j], d;
+
+		if((*inst).metric == METRIC_EUC_2D)
+			d = sqrt((qx - px) * (qx - px) + (qy - py) * (qy - py));
+		else if((*inst).metric == METRIC_CEIL_2D)
+			d = ceil2D(px, py, qx, qy);
+		else if((*inst).metric == METRIC_ATT)
+			d = att(px, py, qx, qy);
+		else
+			d = (i == j) ? 0 : geo(px, py, qx, qy);
+
+		return roundDist(d, (*inst).precision);
+
+	}/* if */
+
+	if((*inst).precision == DIST_NINT)
+		return (*inst).idist[distIndex(i, j, inst)];
+
+	if((*inst).precision == DIST_FLOAT)
+		return (*inst).fdist[distIndex(i, j, inst)];
+
+	return (*inst).dist[distIndex(i, j, inst)];
+
+}/* getDist */
+
+/*
+* IP i node index
+* IP inst tsp instance
+* OR the $inst->ncand candidate neighbours of the node i, nearest first
+*/
+static inline const int* getCandidates(int i, const TSPInstance* inst){
+	return (*inst).cand + (size_t)i * (*inst).ncand;
+}/* getCandidates */
+
+/*
+* IP i node index
+* IP inst tsp instance
+* OR id the node i had when the instance was read/generated, see renumberHilbert
+*/
+static inline int getOriginalId(int i, const TSPInstance* inst){
+	return ((*inst).orig == NULL) ? i : (*inst).orig[i];
+}/* getOriginalId */
+
+/*
+* IP v node
+* IP tour tour
+* OR node visited after $v
+*/
+static inline int tourNext(int v, const TSPTour* tour){
+
+	int i;
+
+	if((*tour).kind == TOUR_TWO_LEVEL)
+		return twoLevelNext(v, &((*tour).tl));
+
+	i = (*tour).pos[v] + 1;
+
+	return (*tour).path[(i == (*tour).n) ? 0 : i];
+
+}/* tourNext */
+
+/*
+* IP v node
+* IP tour tour
+* OR node visited before $v
+*/
+static inline int tourPrev(int v, const TSPTour* tour){
+
+	int i;
+
+	if((*tour).kind == TOUR_TWO_LEVEL)
+		return twoLevelPrev(v, &((*tour).tl));
+
+	i = (*tour).pos[v];
+
+	return (*tour).path[((i == 0) ? (*tour).n : i) - 1];
+
+}/* tourPrev */
+
+/*
+* IP a first node
+* IP b second node
+* IP c third node
+* IP tour tour
+* OR true if $b is met going forward from $a to $c, ends included
+*/
+static inline bool tourBetween(int a, int b, int c, const TSPTour* tour){
+
+	int pa, pb, pc;
+
+	if((*tour).kind == TOUR_TWO_LEVEL)
+		return twoLevelBetween(a, b, c, &((*tour).tl));
+
+	pa = (*tour).pos[a];
+	pb = (*tour).pos[b];
+	pc = (*tour).pos[c];
+
+	if(pa <= pc)
+		return pa <= pb && pb <= pc;
+
+	return pb >= pa || pb <= pc;
+
+}/* tourBetween */
@@ -0,0 +1,266 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : twolevel.c
+*/
+
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+#include "twolevel.h"
+
+/*
+* IP n number of nodes
+* OP tl two-level list to initialize
+*/
+void allocTwoLevel(int n, TwoLevelList* tl){
+
+	int base;
+
+	(*tl).n = n;
+	(*tl).segsize = (int)sqrt(n);
+
+	if((*tl).segsize < TWO_LEVEL_MIN_SEGMENT_SIZE)
+		(*tl).segsize = TWO_LEVEL_MIN_SEGMENT_SIZE;
+
+	base = (n + (*tl).segsize - 1) / (*tl).segsize;
+	(*tl).maxseg = TWO_LEVEL_SEGMENTS_GROWTH * base + 2;
+	(*tl).nseg = 0;
+
+	(*tl).storage = malloc(n * sizeof(int));
+	assert((*tl).storage != NULL);
+
+	(*tl).slot = malloc(n * sizeof(int));
+	assert((*tl).slot != NULL);
+
+	(*tl).seg = malloc(n * sizeof(int));
+	assert((*tl).seg != NULL);
+
+	(*tl).order = malloc((*tl).maxseg * sizeof(int));
+	assert((*tl).order != NULL);
+
+	(*tl).segs = malloc((*tl).maxseg * sizeof(TLSegment));
+	assert((*tl).segs != NULL);
+
+}/* allocTwoLevel */
+
+/*
+* IOP tl two-level list to free memory
+*/
+void freeTwoLevel(TwoLevelList* tl){
+	free((*tl).segs);
+	free((*tl).order);
+	free((*tl).seg);
+	free((*tl).slot);
+	free((*tl).storage);
+}/* freeTwoLevel */
+
+/*
+* IP path nodes in the order they are visited
+* OP tl two-level list of the tour $path, in segments of $tl->segsize nodes
+*/
+void twoLevelFromPath(const int* path, TwoLevelList* tl){
+
+	int i, s;
+
+	(*tl).nseg = ((*tl).n + (*tl).segsize - 1) / (*tl).segsize;
+
+	for(s = 0; s < (*tl).nseg; s++){
+		(*tl).segs[s].lo = s * (*tl).segsize;
+		(*tl).segs[s].hi = ((s + 1) * (*tl).segsize < (*tl).n) ? (s + 1) * (*tl).segsize : (*tl).n;
+		(*tl).segs[s].reversed = false;
+		(*tl).segs[s].rank = s;
+		(*tl).order[s] = s;
+	}/* for */
+
+	for(i = 0; i < (*tl).n; i++){
+		(*tl).storage[i] = path[i];
+		(*tl).slot[path[i]] = i;
+		(*tl).seg[path[i]] = i / (*tl).segsize;
+	}/* for */
+
+}/* twoLevelFromPath */
+
+/*
+* IP tl two-level list
+* OP path nodes in the order they are visited, from the first node of the first segment, array of $tl->n elements
+*/
+void twoLevelToPath(const TwoLevelList* tl, int* path){
+
+	int i, r, k = 0;
+
+	for(r = 0; r < (*tl).nseg; r++){
+
+		const TLSegment* s = &((*tl).segs[(*tl).order[r]]);
+
+		if((*s).reversed)
+			for(i = (*s).hi - 1; i >= (*s).lo; i--)
+				path[k++] = (*tl).storage[i];
+		else
+			for(i = (*s).lo; i < (*s).hi; i++)
+				path[k++] = (*tl).storage[i];
+
+	}/* for */
+
+}/* twoLevelToPath */
+
+/*
+* IOP tl two-level list rebuilt in segments of $tl->segsize nodes, the tour is the same
+* NB: O(n), it takes place once every O(sqrt(n)) reversals
+*/
+void rebuildTwoLevel(TwoLevelList* tl){
+
+	int* path = malloc((*tl).n * sizeof(int));
+	assert(path != NULL);
+
+	twoLevelToPath(tl, path);
+	twoLevelFromPath(path, tl);
+
+	free(path);
+
+}/* rebuildTwoLevel */
+
+/*
+* IP v node
+* IOP tl two-level list whose segment of $v is split so that $v is its first node
+* NB: the part with fewer nodes becomes a new segment next to the old one, O(sqrt(n))
+*/
+void splitTwoLevel(int v, TwoLevelList* tl){
+
+	int s = (*tl).seg[v], t = (*tl).nseg, p = (*tl).slot[v], lo, hi, r, i;
+	TLSegment* old = &((*tl).segs[s]);
+	bool before; /* before := the new segment holds the nodes before $v */
+
+	if(twoLevelFirst(s, tl) == v)
+		return;
+
+	/* in the storage the nodes from v on are [p, hi) or [lo, p] */
+	if((*old).reversed){
+		lo = (*old).lo;
+		hi = p + 1;
+		before = (hi - lo) > ((*old).hi - hi);
+	}else{
+		lo = p;
+		hi = (*old).hi;
+		before = (hi - lo) > (lo - (*old).lo);
+	}/* if */
+
+	if(before){ /* the new segment takes the nodes before v, the complement of [lo, hi) */
+		if((*old).reversed){
+			lo = hi;
+			hi = (*old).hi;
+		}else{
+			hi = lo;
+			lo = (*old).lo;
+		}/* if */
+	}/* if */
+
+	(*tl).segs[t].lo = lo;
+	(*tl).segs[t].hi = hi;
+	(*tl).segs[t].reversed = (*old).reversed;
+
+	if((*old).lo == lo)
+		(*old).lo = hi;
+	else
+		(*old).hi = lo;
+
+	for(i = lo; i < hi; i++)
+		(*tl).seg[(*tl).storage[i]] = t;
+
+	/* t goes right before or right after s in the order */
+	r = before ? (*old).rank : (*old).rank + 1;
+
+	for(i = (*tl).nseg; i > r; i--){
+		(*tl).order[i] = (*tl).order[i - 1];
+		(*tl).segs[(*tl).order[i]].rank = i;
+	}/* for */
+
+	(*tl).order[r] = t;
+	(*tl).segs[t].rank = r;
+	(*tl).nseg++;
+
+}/* splitTwoLevel */
+
+/*
+* IP first first rank of the segments to reverse
+* IP last last rank of the segments to reverse, first <= last
+* IOP tl two-level list whose segments of rank [first, last] are visited in the opposite order and direction
+*/
+void reverseSegments(int first, int last, TwoLevelList* tl){
+
+	for(; first <= last; first++, last--){
+
+		int s = (*tl).order[first], t = (*tl).order[last];
+
+		(*tl).order[first] = t;
+		(*tl).order[last] = s;
+		(*tl).segs[t].rank = first;
+		(*tl).segs[s].rank = last;
+		(*tl).segs[s].reversed = !(*tl).segs[s].reversed;
+
+		if(s != t)
+			(*tl).segs[t].reversed = !(*tl).segs[t].reversed;
+
+	}/* for */
+
+}/* reverseSegments */
+
+/*
+* IP a first node of the path
+* IP b last node of the path
+* IOP tl two-level list whose path from $a forward to $b is reversed
+* NB: if the path goes through the end of the order of the segments, the rest of the tour is reversed instead, that
+*	is the same cycle. Either way O(sqrt(n)).
+*/
+void twoLevelReverse(int a, int b, TwoLevelList* tl){
+
+	int c = twoLevelNext(b, tl), ra, rb;
+
+	if(a == b || c == a)
+		return;
+
+	if((*tl).nseg + 2 > (*tl).maxseg)
+		rebuildTwoLevel(tl);
+
+	splitTwoLevel(a, tl);
+	splitTwoLevel(c, tl);
+
+	ra = (*tl).segs[(*tl).seg[a]].rank;
+	rb = (*tl).segs[(*tl).seg[b]].rank;
+
+	if(ra <= rb)
+		reverseSegments(ra, rb, tl);
+	else
+		reverseSegments(rb + 1, ra - 1, tl);
+
+}/* twoLevelReverse */
+
+/*
+* IP tl two-level list
+* OR true if the segments partition the storage, each node is where its slot and segment say and the ranks are the
+*	inverse of the order
+*/
+bool checkTwoLevel(const TwoLevelList* tl){
+
+	int i, r, size = 0;
+
+	for(r = 0; r < (*tl).nseg; r++){
+
+		const TLSegment* s = &((*tl).segs[(*tl).order[r]]);
+
+		if((*s).rank != r || (*s).lo >= (*s).hi)
+			return false;
+
+		for(i = (*s).lo; i < (*s).hi; i++)
+			if((*tl).storage[i] < 0 || (*tl).storage[i] >= (*tl).n || (*tl).slot[(*tl).storage[i]] != i || (*tl).seg[(*tl).storage[i]] != (*tl).order[r])
+				return false;
+
+		size += (*s).hi - (*s).lo;
+
+	}/* for */
+
+	return size == (*tl).n;
+
+}/* checkTwoLevel */
@@ -0,0 +1,133 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : twolevel.h
+*/
+
+#pragma once
+
+#include <stdbool.h>
+
+#define TWO_LEVEL_MIN_SEGMENT_SIZE 8
+#define TWO_LEVEL_SEGMENTS_GROWTH 2 /* the list is rebuilt when the segments are this many times the ones it starts with */
+
+/* Segment of a two-level list, a range of the storage visited forward or backward */
+typedef struct {
+	int lo, hi;		/* lo, hi   := the segment holds the nodes in storage[lo, hi) */
+	bool reversed;	/* reversed := the nodes are visited from storage[hi - 1] down to storage[lo] */
+	int rank;		/* rank     := position of the segment in the order of the segments */
+} TLSegment;
+
+/*
+* Tour as a list of about sqrt(n) segments of about sqrt(n) nodes each (Fredman et al., 1995). A path is reversed by
+* splitting the segments at its ends and reversing the order and the direction of the segments in between, so it
+* costs O(sqrt(n)) instead of O(n). The nodes never move in the storage until the list is rebuilt.
+*/
+typedef struct {
+	int n;			/* n       := number of nodes */
+	int nseg;		/* nseg    := number of segments in use */
+	int maxseg;		/* maxseg  := number of segments allocated, the list is rebuilt before they run out */
+	int segsize;	/* segsize := size of the segments after a rebuild */
+	int* storage;	/* storage := nodes, each segment holds a range of it */
+	int* slot;		/* slot    := slot[v] position of the node v in $storage */
+	int* seg;		/* seg     := seg[v] segment of the node v */
+	int* order;		/* order   := order[r] segment visited r-th */
+	TLSegment* segs;
+} TwoLevelList;
+
+void allocTwoLevel(int, TwoLevelList*);
+
+void freeTwoLevel(TwoLevelList*);
+
+void twoLevelFromPath(const int*, TwoLevelList*);
+
+void twoLevelToPath(const TwoLevelList*, int*);
+
+void twoLevelReverse(int, int, TwoLevelList*);
+
+bool checkTwoLevel(const TwoLevelList*);
+
+/*
+* IP s segment
+* IP tl two-level list
+* OR first node visited in the segment $s
+*/
+static inline int twoLevelFirst(int s, const TwoLevelList* tl){
+	return (*tl).segs[s].reversed ? (*tl).storage[(*tl).segs[s].hi - 1] : (*tl).storage[(*tl).segs[s].lo];
+}/* twoLevelFirst */
+
+/*
+* IP s segment
+* IP tl two-level list
+* OR last node visited in the segment $s
+*/
+static inline int twoLevelLast(int s, const TwoLevelList* tl){
+	return (*tl).segs[s].reversed ? (*tl).storage[(*tl).segs[s].lo] : (*tl).storage[(*tl).segs[s].hi - 1];
+}/* twoLevelLast */
+
+/*
+* IP v node
+* IP tl two-level list
+* OR node visited after $v
+*/
+static inline int twoLevelNext(int v, const TwoLevelList* tl){
+
+	const TLSegment* s = &((*tl).segs[(*tl).seg[v]]);
+	int p = (*tl).slot[v] + ((*s).reversed ? -1 : 1);
+
+	if(p >= (*s).lo && p < (*s).hi)
+		return (*tl).storage[p];
+
+	return twoLevelFirst((*tl).order[((*s).rank + 1 == (*tl).nseg) ? 0 : (*s).rank + 1], tl);
+
+}/* twoLevelNext */
+
+/*
+* IP v node
+* IP tl two-level list
+* OR node visited before $v
+*/
+static inline int twoLevelPrev(int v, const TwoLevelList* tl){
+
+	const TLSegment* s = &((*tl).segs[(*tl).seg[v]]);
+	int p = (*tl).slot[v] + ((*s).reversed ? 1 : -1);
+
+	if(p >= (*s).lo && p < (*s).hi)
+		return (*tl).storage[p];
+
+	return twoLevelLast((*tl).order[(((*s).rank == 0) ? (*tl).nseg : (*s).rank) - 1], tl);
+
+}/* twoLevelPrev */
+
+/*
+* IP v node
+* IP tl two-level list
+* OR position of $v in the tour, the order of the positions is the one of the visit (they are not contiguous)
+*/
+static inline long long twoLevelKey(int v, const TwoLevelList* tl){
+
+	const TLSegment* s = &((*tl).segs[(*tl).seg[v]]);
+	int offset = (*s).reversed ? (*s).hi - 1 - (*tl).slot[v] : (*tl).slot[v] - (*s).lo;
+
+	return (long long)(*s).rank * (*tl).n + offset;
+
+}/* twoLevelKey */
+
+/*
+* IP a first node
+* IP b second node
+* IP c third node
+* IP tl two-level list
+* OR true if $b is met going forward from $a to $c, ends included
+*/
+static inline bool twoLevelBetween(int a, int b, int c, const TwoLevelList* tl){
+
+	long long pa = twoLevelKey(a, tl), pb = twoLevelKey(b, tl), pc = twoLevelKey(c, tl);
+
+	if(pa <= pc)
+		return pa <= pb && pb <= pc;
+
+	return pb >= pa || pb <= pc;
+
+}/* twoLevelBetween */
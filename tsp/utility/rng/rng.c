@@ -0,0 +1,167 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : rng.c
+*/
+
+#include <stdbool.h>
+
+#include "rng.h"
+
+static uint64_t globalSeed = 0;			/* seed of all the streams, set by rngSeed */
+static __thread RNG threadRNG;			/* generator of the calling thread */
+static __thread bool threadReady = false;	/* true once $threadRNG is initialised */
+
+/*
+* IOP x splitmix64 state
+* OR next splitmix64 output
+* NB: used only to spread a seed over the xoshiro state, as its authors suggest
+*/
+uint64_t splitmix64(uint64_t* x){
+
+	uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+	return z ^ (z >> 31);
+
+}/* splitmix64 */
+
+/*
+* IP x value to rotate
+* IP k number of bits
+* OR $x rotated left by $k bits
+*/
+static inline uint64_t rotl(uint64_t x, int k){
+	return (x << k) | (x >> (64 - k));
+}/* rotl */
+
+/*
+* IOP rng generator
+* OR next 64 random bits
+*/
+uint64_t rngNext(RNG* rng){
+
+	uint64_t* s = (*rng).s;
+	uint64_t result = rotl(s[1] * 5, 7) * 9, t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl(s[3], 45);
+
+	return result;
+
+}/* rngNext */
+
+/*
+* IOP rng generator moved 2^128 draws ahead
+* NB: xoshiro256** jump function, 2^128 streams of 2^128 draws that never overlap
+*/
+void rngJump(RNG* rng){
+
+	static const uint64_t jump[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+	uint64_t s[4] = { 0, 0, 0, 0 };
+	int i, b, k;
+
+	for(i = 0; i < 4; i++)
+		for(b = 0; b < 64; b++){
+			if(jump[i] & ((uint64_t)1 << b))
+				for(k = 0; k < 4; k++)
+					s[k] ^= (*rng).s[k];
+			rngNext(rng);
+		}/* for */
+
+	for(k = 0; k < 4; k++)
+		(*rng).s[k] = s[k];
+
+}/* rngJump */
+
+/*
+* IP seed seed
+* IP stream index of the stream, >= 0
+* OP rng generator at the beginning of the stream $stream of $seed
+* NB: the same seed and stream always give the same sequence, whatever thread draws it
+*/
+void rngInit(uint64_t seed, int stream, RNG* rng){
+
+	int k;
+
+	for(k = 0; k < 4; k++)
+		(*rng).s[k] = splitmix64(&seed);
+
+	for(k = 0; k < stream; k++)
+		rngJump(rng);
+
+}/* rngInit */
+
+/*
+* IOP rng generator
+* IP n upper bound, > 0
+* OR random integer in [0, $n - 1], without the bias of the modulo
+* NB: Lemire's multiply-shift on the high 32 bits, the draws below the threshold (less than n out of 2^32) are redone
+*/
+int rngBelow(RNG* rng, int n){
+
+	uint32_t bound = n, threshold;
+	uint64_t m = (rngNext(rng) >> 32) * bound;
+
+	if((uint32_t)m < bound){
+		threshold = -bound % bound;
+		while((uint32_t)m < threshold)
+			m = (rngNext(rng) >> 32) * bound;
+	}/* if */
+
+	return m >> 32;
+
+}/* rngBelow */
+
+/*
+* IOP rng generator
+* OR random double in [0, 1) with 53 random bits
+*/
+double rngUniform(RNG* rng){
+	return (rngNext(rng) >> 11) * 0x1.0p-53;
+}/* rngUniform */
+
+/*
+* IP seed seed of all the streams
+* NB: the calling thread restarts from the beginning of RNG_MAIN_STREAM, the other threads restart at their next
+*	rngSelectStream. It must be called before the threads that draw are started.
+*/
+void rngSeed(uint64_t seed){
+
+	globalSeed = seed;
+
+	rngInit(globalSeed, RNG_MAIN_STREAM, &threadRNG);
+	threadReady = true;
+
+}/* rngSeed */
+
+/*
+* IP stream index of the stream the calling thread draws from
+* NB: a parallel heuristic gives each thread its own index (e.g. the thread number), so that each thread draws the
+*	same numbers at every run, however the threads are scheduled
+*/
+void rngSelectStream(int stream){
+
+	rngInit(globalSeed, stream, &threadRNG);
+	threadReady = true;
+
+}/* rngSelectStream */
+
+/*
+* OR generator of the calling thread, at the beginning of RNG_MAIN_STREAM if the thread did not select a stream
+*/
+RNG* rngThread(void){
+
+	if(!threadReady)
+		rngSelectStream(RNG_MAIN_STREAM);
+
+	return &threadRNG;
+
+}/* rngThread */
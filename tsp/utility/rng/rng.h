@@ -0,0 +1,35 @@
+/*
+* Project  : Travelling Salesman Problem implementations
+* Authors  : Luigi Frigione, Daniel Carlesso
+* IDs      : 2060685, 2088626
+* File     : rng.h
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#define RNG_MAIN_STREAM 0 /* stream of the threads that do not select one, the main thread among them */
+
+/* xoshiro256** generator, period 2^256 - 1 */
+typedef struct {
+	uint64_t s[4];	/* s := state, never all zeros */
+} RNG;
+
+uint64_t splitmix64(uint64_t*);
+
+void rngInit(uint64_t, int, RNG*);
+
+void rngJump(RNG*);
+
+uint64_t rngNext(RNG*);
+
+int rngBelow(RNG*, int);
+
+double rngUniform(RNG*);
+
+void rngSeed(uint64_t);
+
+void rngSelectStream(int);
+
+RNG* rngThread(void);
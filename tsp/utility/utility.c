@@ -11,9 +11,18 @@
 #include <math.h>
 #include <string.h>
 #include <ctype.h>
+#include <pthread.h>
 #include <sys/types.h>
 #include <sys/sysctl.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "utility.h"
 
 #define EPSILON 1e-7
@@ -50,11 +59,11 @@ void printBool(const char lab[], bool b) {
 /*
 * IP n
 * OR random integer value in [0, $n - 1]
-* Note: rand() returns an integer value in the range [0, RAND_MAX - 1]
+* Note: drawn from the stream of the calling thread (see rng.h), so threads do not share any state
 */
 int rand0N(int n){
 
-    return rand() % n;
+    return rngBelow(rngThread(), n);
 
 }/* rand0N */
 
@@ -72,6 +81,20 @@ void swapInt(int* a, int* b){
 
 }/* swapInt */
 
+/*
+* IP a pointer to a double
+* IP b pointer to a double
+*/
+void swapDouble(double* a, double* b){
+
+	double temp;
+
+	temp = *a;
+	*a = *b;
+	*b = temp;
+
+}/* swapDouble */
+
 /*
 * Read integer in input.
 * IP lab label for the output
@@ -170,8 +193,9 @@ double getSeconds(time_t start){
 * IP start starting point of arr's sublist to invert
 * IP end ending point of arr's sublist to invert
 * IOP arr list to be inverted
+* NB: one swap at a time, reference version of invertArray
 */
-void invertArray(int start, int end, int* arr){
+void invertArrayScalar(int start, int end, int* arr){
     
     int delta = end - start;
 
@@ -183,8 +207,94 @@ void invertArray(int start, int end, int* arr){
 
     }
     
+}/* invertArrayScalar */
+
+/*
+* IOP lo first element of the first block
+* IOP hi last element of the second block
+* IP count number of swaps, lo[count - 1] has to come before hi[1 - count]
+* NB: lo[k] and hi[-k] are swapped for each k < count. Whole vectors are loaded from both ends, their lanes are
+*	reversed by a shuffle and they are stored crosswise (AVX2, SSE2 or NEON, whatever the compiler targets), the
+*	tail is swapped one element at a time.
+*/
+void swapReversed(int* lo, int* hi, int count){
+
+	int k = 0;
+
+#if defined(__AVX2__)
+	const __m256i rev = _mm256_set_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+	for(; k + 8 <= count; k += 8){
+		__m256i a = _mm256_loadu_si256((const __m256i*)(lo + k));
+		__m256i b = _mm256_loadu_si256((const __m256i*)(hi - k - 7));
+		_mm256_storeu_si256((__m256i*)(lo + k), _mm256_permutevar8x32_epi32(b, rev));
+		_mm256_storeu_si256((__m256i*)(hi - k - 7), _mm256_permutevar8x32_epi32(a, rev));
+	}/* for */
+#elif defined(__SSE2__)
+	for(; k + 4 <= count; k += 4){
+		__m128i a = _mm_loadu_si128((const __m128i*)(lo + k));
+		__m128i b = _mm_loadu_si128((const __m128i*)(hi - k - 3));
+		_mm_storeu_si128((__m128i*)(lo + k), _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 1, 2, 3)));
+		_mm_storeu_si128((__m128i*)(hi - k - 3), _mm_shuffle_epi32(a, _MM_SHUFFLE(0, 1, 2, 3)));
+	}/* for */
+#elif defined(__ARM_NEON)
+	for(; k + 4 <= count; k += 4){
+		int32x4_t a = vrev64q_s32(vld1q_s32(lo + k));
+		int32x4_t b = vrev64q_s32(vld1q_s32(hi - k - 3));
+		vst1q_s32(lo + k, vextq_s32(b, b, 2));
+		vst1q_s32(hi - k - 3, vextq_s32(a, a, 2));
+	}/* for */
+#endif
+
+	for(; k < count; k++)
+		swapInt(&(lo[k]), &(hi[-k]));
+
+}/* swapReversed */
+
+/*
+* IP start starting point of arr's sublist to invert
+* IP end ending point of arr's sublist to invert
+* IOP arr list to be inverted
+* NB: vectorised, see swapReversed
+*/
+void invertArray(int start, int end, int* arr){
+
+	if(end > start)
+		swapReversed(arr + start, arr + end, (end - start + 1) / 2);
+
 }/* invertArray */
 
+/*
+* IP n number of elements of arr
+* IP start starting point of arr's sublist to invert
+* IP end ending point of arr's sublist to invert, if end < start the sublist goes on from arr[n - 1] to arr[0]
+* IOP arr cyclic list to be inverted
+* NB: the swaps are split in runs where neither end wraps around, each run is vectorised, see swapReversed
+*/
+void invertArrayCyclic(int n, int start, int end, int* arr){
+
+	int count = ((end - start + n) % n + 1) / 2;
+
+	while(count > 0){
+
+		int run = count;
+
+		if(run > n - start)
+			run = n - start;
+
+		if(run > end + 1)
+			run = end + 1;
+
+		swapReversed(arr + start, arr + end, run);
+
+		count -= run;
+		start = (start + run == n) ? 0 : start + run;
+		end = (end - run < 0) ? n - 1 : end - run;
+
+	}/* while */
+
+}/* invertArrayCyclic */
+
 /*
 * IP n dividend
 * IP d divisor
@@ -530,6 +640,45 @@ unsigned int get_hardware_concurrency(void) {
 
 }/* get_hardware_concurrency */
 
+/*
+* IOP chunks array of $nt chunks, each of $size bytes
+* IP size size of a chunk
+* IP nt number of chunks
+* IP f pthread entry point run on each chunk
+* NB: the chunks from the second on run each on a new thread, the calling thread runs the first one and the ones whose
+*	thread cannot be created. It returns when every chunk is done.
+*/
+void runChunks(void* chunks, size_t size, int nt, void* (*f)(void*)){
+
+	int t;
+	pthread_t* threads;
+	bool* started;
+
+	if(nt < 1)
+		return;
+
+	threads = malloc(nt * sizeof(pthread_t));
+	assert(threads != NULL);
+
+	started = malloc(nt * sizeof(bool));
+	assert(started != NULL);
+
+	for(t = 0; t < nt; t++)
+		started[t] = (t > 0) && !pthread_create(&(threads[t]), NULL, f, (char*)chunks + t * size);
+
+	for(t = 0; t < nt; t++)
+		if(!started[t])
+			f((char*)chunks + t * size);
+
+	for(t = 0; t < nt; t++)
+		if(started[t])
+			pthread_join(threads[t], NULL);
+
+	free(started);
+	free(threads);
+
+}/* runChunks */
+
 /*
 * IP d1 first double
 * IP d2 second double
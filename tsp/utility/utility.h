@@ -8,10 +8,12 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <time.h>
 
 #include "../array/array.h"
 #include "../input/settings/settings.h"
+#include "rng/rng.h"
 
 #define MAX_STRING_LENGTH 65
 #define PRINT_FREQUENCY 1 /* seconds between one print and another */
@@ -23,6 +25,8 @@ int rand0N(int);
 
 void swapInt(int*, int*);
 
+void swapDouble(double*, double*);
+
 int readInt(const char[]);
 
 bool isEqualPrecision(double, double, double);
@@ -35,8 +39,14 @@ void printSeconds(const char[], int);
 
 int readIntRange(int, int, const char[]);
 
+void invertArrayScalar(int, int, int*);
+
+void swapReversed(int*, int*, int);
+
 void invertArray(int, int, int*);
 
+void invertArrayCyclic(int, int, int, int*);
+
 bool isTimeOut(time_t, int);
 
 bool isTimeOutWarning(const char[], time_t, int, bool);
@@ -63,6 +73,8 @@ bool readBool(const char[]);
 
 unsigned int get_hardware_concurrency(void);
 
+void runChunks(void*, size_t, int, void* (*)(void*));
+
 double min_dbl(double, double);
 
 bool reservoirSampling(const ArrayDinaInt*, ArrayDinaInt*);